@@ -1,17 +1,28 @@
 #!/usr/bin/env python3
 
 import hashlib
+import re
 import shutil
+import threading
 import uuid
 import zipfile
 from pathlib import Path
+from typing import Dict, Optional
+
+from werkzeug.datastructures import FileStorage
 
 import click
 from flask import Flask, jsonify, request, Response
 from loguru import logger
 
+from federated_index import FederatedIndex
 from joern_analyzer import JoernAnalyzer
 from results_processor import ResultsProcessor
+from settings import ANALYSIS_MODES
+from utils.graph_export import EXPORT_FORMATS
+from utils.metrics import METRICS
+from utils.tracing import SPAN_KIND_SERVER, TRACER
+from utils.zip_extraction import ZipExtraction
 
 app = Flask(__name__)
 
@@ -21,6 +32,14 @@ RESULTS_DIR = Path.cwd() / "results"
 CODE_DIR.mkdir(exist_ok=True)
 RESULTS_DIR.mkdir(exist_ok=True)
 
+# A code ID is the SHA-512 hash of the uploaded zip file
+CODE_ID_PATTERN = re.compile(r"[0-9a-f]{128}")
+
+# Running extractions by code ID, so that concurrent requests for the same code wait
+# for the running extraction instead of extracting it again or reading a partial tree
+EXTRACTIONS: Dict[str, ZipExtraction] = {}
+EXTRACTIONS_LOCK = threading.Lock()
+
 
 def calculate_zip_hash(zip_path: Path) -> str:
     """Calculate SHA-512 hash of a zip file."""
@@ -32,6 +51,94 @@ def calculate_zip_hash(zip_path: Path) -> str:
     return sha512_hash.hexdigest()
 
 
+def save_upload(file: FileStorage, zip_path: Path) -> str:
+    """Save an uploaded zip file and calculate its SHA-512 hash while writing it.
+
+    Args:
+        file: The uploaded file
+        zip_path: Path to save the file to
+
+    Returns:
+        str: The hash, the same as calculate_zip_hash() of the saved file
+    """
+    sha512_hash = hashlib.sha512()
+    with open(zip_path, "wb") as f:
+        for byte_block in iter(lambda: file.stream.read(64 * 1024), b""):
+            sha512_hash.update(byte_block)
+            f.write(byte_block)
+    return sha512_hash.hexdigest()
+
+
+def extract_upload(code_id: str, zip_path: Path) -> Optional[ZipExtraction]:
+    """Start extracting an uploaded zip file, unless the code is extracted or being extracted.
+
+    The zip file is removed in any case.
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+        zip_path: The saved zip file
+
+    Returns:
+        Optional[ZipExtraction]: The running extraction of the code, None if the code
+            is extracted already
+
+    Raises:
+        zipfile.BadZipFile: If the file is not a zip archive
+    """
+    target_dir = CODE_DIR / code_id
+    with EXTRACTIONS_LOCK:
+        extraction = EXTRACTIONS.get(code_id)
+        if extraction is not None or target_dir.exists():
+            zip_path.unlink()
+            return extraction
+        try:
+            extraction = ZipExtraction(zip_path, target_dir, on_finished=lambda: _forget_extraction(code_id))
+        except zipfile.BadZipFile:
+            zip_path.unlink()
+            raise
+        EXTRACTIONS[code_id] = extraction.start()
+        return extraction
+
+
+def _forget_extraction(code_id: str) -> None:
+    """Remove a finished extraction from the running extractions."""
+    with EXTRACTIONS_LOCK:
+        EXTRACTIONS.pop(code_id, None)
+
+
+def _code_id_error(*code_ids: str) -> Optional[tuple[Response, int]]:
+    """Check that code IDs are SHA-512 hashes, before they are used in paths.
+
+    Args:
+        code_ids: The code IDs of the request
+
+    Returns:
+        Optional[tuple[Response, int]]: The 400 response if one is not, None otherwise
+    """
+    if not all(CODE_ID_PATTERN.fullmatch(code_id) for code_id in code_ids):
+        return jsonify({"error": "Invalid code ID"}), 400
+    return None
+
+
+def _zip_upload_error() -> Optional[tuple[Response, int]]:
+    """Check that the request has a zip file in its 'file' field.
+
+    Returns:
+        Optional[tuple[Response, int]]: The 400 response if it has not, None otherwise
+    """
+    if "file" not in request.files:
+        return jsonify({"error": "No file provided"}), 400
+
+    file = request.files["file"]
+    if file.filename == "":
+        return jsonify({"error": "No file selected"}), 400
+
+    if not file.filename.endswith(".zip"):
+        return jsonify({"error": "File must be a zip file"}), 400
+
+    return None
+
+
 @app.route("/upload_code", methods=["POST"])
 def upload_code() -> tuple[Response, int]:
     """Handle code upload via zip file.
@@ -51,17 +158,13 @@ def upload_code() -> tuple[Response, int]:
         - 500: Server error during processing
 
     The uploaded code is stored in the CODE_DIR directory, with each upload
-    getting its own subdirectory named by the hash of the zip contents.
+    getting its own subdirectory named by the hash of the zip contents, which
+    only exists once the extraction is complete (see ZipExtraction).
     """
-    if "file" not in request.files:
-        return jsonify({"error": "No file provided"}), 400
-
+    error = _zip_upload_error()
+    if error:
+        return error
     file = request.files["file"]
-    if file.filename == "":
-        return jsonify({"error": "No file selected"}), 400
-
-    if not file.filename.endswith(".zip"):
-        return jsonify({"error": "File must be a zip file"}), 400
 
     try:
         # Create a temporary file for the zip
@@ -70,21 +173,16 @@ def upload_code() -> tuple[Response, int]:
 
         # Calculate hash of the zip file
         code_id = calculate_zip_hash(temp_zip)
-        target_dir = CODE_DIR / code_id
         results_dir = RESULTS_DIR / code_id
 
-        # Only extract if directory doesn't exist
-        if not target_dir.exists():
-            target_dir.mkdir(exist_ok=True)
-            with zipfile.ZipFile(temp_zip, "r") as zip_ref:
-                zip_ref.extractall(target_dir)
+        # Only extract if the code is neither extracted nor being extracted
+        extraction = extract_upload(code_id, temp_zip)
+        if extraction:
+            extraction.wait()
 
         # Create results directory if it doesn't exist
         results_dir.mkdir(exist_ok=True)
 
-        # Clean up temporary zip file
-        temp_zip.unlink()
-
         return jsonify({"message": "Code uploaded successfully", "code_id": code_id}), 200
 
     except Exception as e:
@@ -92,13 +190,67 @@ def upload_code() -> tuple[Response, int]:
         # Clean up on error
         if "temp_zip" in locals() and temp_zip.exists():
             temp_zip.unlink()
-        if "target_dir" in locals() and target_dir.exists() and not any(target_dir.iterdir()):
-            shutil.rmtree(target_dir)
         if "results_dir" in locals() and results_dir.exists() and not any(results_dir.iterdir()):
             shutil.rmtree(results_dir)
         return jsonify({"error": str(e)}), 500
 
 
+@app.route("/analyze", methods=["POST"])
+def upload_and_analyze() -> tuple[Response, int]:
+    """Upload code via zip file and analyze it in one request.
+
+    Unlike /upload_code followed by /call_graph/<code_id>, the analysis does not wait
+    for the extraction: while the zip file is extracted, the analysis waits for free
+    resources and starts the Joern container, so the latency is the longer of the two
+    instead of their sum. Code that was uploaded before is not extracted again.
+
+    Request:
+        - Method: POST
+        - Content-Type: multipart/form-data
+        - Body: Form data with 'file' field containing a zip file
+        - Query parameters: As for /call_graph/<code_id>
+
+    Returns:
+        - 200: Success response with the results of /call_graph/<code_id> and the code_id
+        - 400: Bad request (no file, empty file, non-zip file or unknown mode)
+        - 500: Server error during extraction or analysis
+    """
+    with TRACER.span(
+        "POST /analyze",
+        kind=SPAN_KIND_SERVER,
+        traceparent=request.headers.get("traceparent"),
+        attributes={"http.route": "/analyze"},
+    ) as span:
+        response, status = _upload_and_analyze()
+        span.set_attribute("http.response.status_code", status)
+        if status >= 500:
+            span.set_error(f"HTTP {status}")
+        return response, status
+
+
+def _upload_and_analyze() -> tuple[Response, int]:
+    """Save the uploaded code, start its extraction and analyze it, see upload_and_analyze()."""
+    error = _zip_upload_error()
+    if error:
+        return error
+
+    temp_zip = CODE_DIR / f"temp_{uuid.uuid4()}.zip"
+    try:
+        code_id = save_upload(request.files["file"], temp_zip)
+    except Exception as e:
+        logger.error(f"Error processing upload: {str(e)}")
+        temp_zip.unlink(missing_ok=True)
+        return jsonify({"error": str(e)}), 500
+
+    (RESULTS_DIR / code_id).mkdir(exist_ok=True)
+    try:
+        extraction = extract_upload(code_id, temp_zip)
+    except zipfile.BadZipFile:
+        return jsonify({"error": "File is not a valid zip file"}), 400
+
+    return _analyze_and_get_call_graph(code_id, extraction=extraction, with_code_id=True)
+
+
 @app.route("/call_graph/<code_id>", methods=["GET"])
 def get_call_graph(code_id: str) -> tuple[Response, int]:
     """Analyze code and return call graph results.
@@ -110,8 +262,15 @@ def get_call_graph(code_id: str) -> tuple[Response, int]:
     Args:
         code_id: The unique identifier of the uploaded code (SHA-512 hash)
 
+    Query parameters:
+        - profile: "true" or "1" to record c2cpg and the analysis script with Java
+          Flight Recorder into the profiles/ subdirectory of the results
+        - mode: "signatures" for a lightweight index of the functions and calls
+          without function code, or "full" (default from settings.py)
+
     Returns:
         - 200: Success response with analysis results
+        - 400: Invalid code ID or unknown mode
         - 404: Code ID not found
         - 500: Server error during analysis
 
@@ -121,21 +280,60 @@ def get_call_graph(code_id: str) -> tuple[Response, int]:
         - cleaned_functions: Cleaned function data
         - cleaned_call_graph: Cleaned call graph data
         - call_graph_tree: Formatted call graph tree
+        - dead_functions: Functions unreachable from the entry points
+    """
+    error = _code_id_error(code_id)
+    if error:
+        return error
+
+    with TRACER.span(
+        "GET /call_graph",
+        kind=SPAN_KIND_SERVER,
+        traceparent=request.headers.get("traceparent"),
+        attributes={"http.route": "/call_graph/<code_id>", "code.id": code_id},
+    ) as span:
+        response, status = _analyze_and_get_call_graph(code_id)
+        span.set_attribute("http.response.status_code", status)
+        if status >= 500:
+            span.set_error(f"HTTP {status}")
+        return response, status
+
+
+def _analyze_and_get_call_graph(
+    code_id: str, extraction: Optional[ZipExtraction] = None, with_code_id: bool = False
+) -> tuple[Response, int]:
+    """Analyze code and return call graph results, see get_call_graph().
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+        extraction: Running extraction of the code, see upload_and_analyze(); by
+            default, the running extraction of an upload of the same code if any
+        with_code_id: Whether to add the code_id to the results
     """
     code_path = CODE_DIR / code_id
     results_path = RESULTS_DIR / code_id
+    if extraction is None:
+        with EXTRACTIONS_LOCK:
+            extraction = EXTRACTIONS.get(code_id)
 
     logger.debug(f"API: code_path={code_path}, results_path={results_path}")
 
-    if not code_path.exists():
+    if extraction is None and not code_path.exists():
         logger.error(f"API: Code path does not exist for code_id={code_id}")
         return jsonify({"error": "Code ID not found"}), 404
 
     try:
         # Initialize and run analyzer
-        analyzer = JoernAnalyzer()
+        mode = request.args.get("mode")
+        if mode is not None and mode not in ANALYSIS_MODES:
+            return jsonify({"error": f"Unknown mode, expected one of {ANALYSIS_MODES}"}), 400
+        analyzer = JoernAnalyzer(
+            profile=request.args.get("profile", "").lower() in ("1", "true") or None,
+            backend=app.config.get("BACKEND"),
+            mode=mode,
+        )
         try:
-            analyzer.analyze(code_path, results_path)
+            analyzer.analyze(code_path, results_path, extraction=extraction)
         except RuntimeError as e:
             logger.error(f"API: Analyzer runtime error: {e}")
             return jsonify({"error": str(e)}), 500
@@ -181,24 +379,461 @@ def get_call_graph(code_id: str) -> tuple[Response, int]:
                 logger.error("API: Analysis result files are empty on disk")
                 return jsonify({"error": "Analysis results are empty"}), 500
 
-        # Process results
-        processor = ResultsProcessor(results_path)
-        results = processor.get_all_results(analyzer.functions_info or [], analyzer.call_graph or [])
+        # The analyzer has already processed the results, so only read them
+        processor = ResultsProcessor(results_path, timings=analyzer.timings)
+        with analyzer.timings.phase("load_results"):
+            results = processor.read_all_results()
+        if with_code_id:
+            results["code_id"] = code_id
         logger.debug(f"API: Returning results with keys: {list(results.keys())}")
 
-        return jsonify(results), 200
+        with analyzer.timings.phase("response_encode"):
+            response = jsonify(results)
+        analyzer.timings.save(processor._get_result_paths().timings)
+
+        return response, 200
 
     except Exception as e:
         logger.error(f"API: Error analyzing code: {str(e)}")
         return jsonify({"error": str(e)}), 500
 
 
+@app.route("/status/<code_id>", methods=["GET"])
+def get_status(code_id: str) -> tuple[Response, int]:
+    """Return the status, phase timings and resource usage of the analysis of a code ID.
+
+    While the analysis runs, the resource usage of the Joern container is sampled
+    from its cgroup, so the response reflects the usage so far.
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+
+    Returns:
+        - 200: Success response with the status
+        - 400: Invalid code ID
+        - 404: Code ID not found or not analyzed yet
+
+    The response includes:
+        - status: "running", "success" or "failure"
+        - total_seconds, phases, sizes and counts: As in timings.json
+        - resources: CPU time, current and peak memory, block I/O and OOM kills of
+          the container, e.g. container_cpu_seconds and container_memory_peak_bytes
+    """
+    error = _code_id_error(code_id)
+    if error:
+        return error
+
+    results_path = RESULTS_DIR / code_id
+    if not results_path.exists():
+        return jsonify({"error": "Code ID not found"}), 404
+
+    try:
+        return jsonify(ResultsProcessor(results_path).load_status()), 200
+    except FileNotFoundError:
+        return jsonify({"error": "Status not found, run /call_graph first"}), 404
+
+
+@app.route("/components/<code_id>", methods=["GET"])
+def get_components(code_id: str) -> tuple[Response, int]:
+    """Return the strongly connected components of the call graph of analyzed code.
+
+    The components are computed once during analysis, so the code must have been
+    analyzed via /call_graph/<code_id> before.
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+
+    Returns:
+        - 200: Success response with the components
+        - 400: Invalid code ID
+        - 404: Code ID or components not found
+
+    The response includes:
+        - function_components: Component id of each function
+        - components: Member functions of each component
+        - recursive: Functions that are part of a (mutual) recursion cycle
+        - dag: Condensed call graph in CSR form
+    """
+    error = _code_id_error(code_id)
+    if error:
+        return error
+
+    results_path = RESULTS_DIR / code_id
+    if not results_path.exists():
+        return jsonify({"error": "Code ID not found"}), 404
+
+    try:
+        return jsonify(ResultsProcessor(results_path).load_components()), 200
+    except FileNotFoundError:
+        return jsonify({"error": "Components not found, run /call_graph first"}), 404
+
+
+@app.route("/entry_points/<code_id>", methods=["GET"])
+def get_entry_points(code_id: str) -> tuple[Response, int]:
+    """Return the call depths and dominator trees of the entry points of analyzed code.
+
+    These are computed once during analysis, for the entry points configured in
+    settings.py, so the code must have been analyzed via /call_graph/<code_id> before.
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+
+    Returns:
+        - 200: Success response with the entry point results
+        - 400: Invalid code ID
+        - 404: Code ID or entry point results not found
+
+    The response includes:
+        - names: Function names; the arrays below are indexed like this list
+        - entry_points: For each entry point, "depth" (minimum call depth, -1 if
+          unreachable) and "idom" (index of the immediate dominator, -1 if unreachable)
+    """
+    error = _code_id_error(code_id)
+    if error:
+        return error
+
+    results_path = RESULTS_DIR / code_id
+    if not results_path.exists():
+        return jsonify({"error": "Code ID not found"}), 404
+
+    try:
+        return jsonify(ResultsProcessor(results_path).load_entry_points()), 200
+    except FileNotFoundError:
+        return jsonify({"error": "Entry points not found, run /call_graph first"}), 404
+
+
+@app.route("/reachability/<code_id>", methods=["POST"])
+def get_reachability(code_id: str) -> tuple[Response, int]:
+    """Answer many-to-many reachability queries for analyzed code.
+
+    This endpoint uses the reachability index built during analysis, so the code
+    must have been analyzed via /call_graph/<code_id> before.
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+
+    Request:
+        - Method: POST
+        - Content-Type: application/json
+        - Body: {"sources": [...], "targets": [...]}; targets are optional and
+          default to the system functions found in the code
+
+    Returns:
+        - 200: Success response with "reachable" (sorted reachable targets per
+          source) and "unknown" (requested functions that are not in the call graph)
+        - 400: Bad request (invalid code ID, missing or malformed sources/targets,
+          or a name that is not a string)
+        - 404: Code ID or reachability index not found
+        - 500: Server error during the query
+    """
+    error = _code_id_error(code_id)
+    if error:
+        return error
+
+    body = request.get_json(silent=True) or {}
+    sources = body.get("sources")
+    targets = body.get("targets")
+    if not isinstance(sources, list) or (targets is not None and not isinstance(targets, list)):
+        return jsonify({"error": "Body must contain a 'sources' list and an optional 'targets' list"}), 400
+    if not all(isinstance(name, str) for name in sources + (targets or [])):
+        return jsonify({"error": "Sources and targets must be function names (strings)"}), 400
+
+    results_path = RESULTS_DIR / code_id
+    if not results_path.exists():
+        return jsonify({"error": "Code ID not found"}), 404
+
+    try:
+        index = ResultsProcessor(results_path).load_reachability_index()
+    except FileNotFoundError:
+        return jsonify({"error": "Reachability index not found, run /call_graph first"}), 404
+
+    try:
+        reachable = index.reachable_targets(sources, targets)
+        unknown = index.unknown_functions(sources + (targets or []))
+        return jsonify({"reachable": reachable, "unknown": sorted(unknown)}), 200
+
+    except Exception as e:
+        logger.error(f"API: Error answering reachability query: {str(e)}")
+        return jsonify({"error": str(e)}), 500
+
+
+@app.route("/diff/<old_id>/<new_id>", methods=["GET"])
+def get_diff(old_id: str, new_id: str) -> tuple[Response, int]:
+    """Return how the call graph changed between two analyzed code IDs.
+
+    Both code IDs must have been analyzed via /call_graph/<code_id> before. Diffs
+    are cached per pair and only files whose functions or calls changed are compared.
+
+    Args:
+        old_id: The code ID of the old version
+        new_id: The code ID of the new version
+
+    Returns:
+        - 200: Success response with the diff
+        - 400: Invalid code ID
+        - 404: Code ID or analysis results not found
+        - 500: Server error while computing the diff
+
+    The response includes:
+        - functions: Added and removed functions (name, file)
+        - edges: Added and removed call edges (caller, callee, file)
+        - files: Number of changed and unchanged files
+    """
+    error = _code_id_error(old_id, new_id)
+    if error:
+        return error
+
+    old_path = RESULTS_DIR / old_id
+    new_path = RESULTS_DIR / new_id
+    if not old_path.exists() or not new_path.exists():
+        return jsonify({"error": "Code ID not found"}), 404
+
+    try:
+        return jsonify(ResultsProcessor(new_path).diff_results(old_path)), 200
+    except FileNotFoundError:
+        return jsonify({"error": "Analysis results not found, run /call_graph first"}), 404
+    except Exception as e:
+        logger.error(f"API: Error computing diff: {str(e)}")
+        return jsonify({"error": str(e)}), 500
+
+
+@app.route("/export/<code_id>/<export_format>", methods=["GET"])
+def export_call_graph(code_id: str, export_format: str) -> tuple[Response, int]:
+    """Stream the cleaned call graph of analyzed code in a graph exchange format.
+
+    The export is generated line by line while it is sent, so large call graphs
+    are never held in memory as a whole document.
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+        export_format: One of "dot", "graphml", "neo4j_nodes" or "neo4j_edges";
+            the Neo4j CSV files are meant for neo4j-admin database import and use
+            "<code_id>:<node>" as node ids, so several code IDs can be imported together
+
+    Returns:
+        - 200: Streamed export
+        - 400: Invalid code ID or unknown export format
+        - 404: Code ID or analysis results not found
+    """
+    error = _code_id_error(code_id)
+    if error:
+        return error
+    if export_format not in EXPORT_FORMATS:
+        return jsonify({"error": f"Export format must be one of: {', '.join(EXPORT_FORMATS)}"}), 400
+
+    results_path = RESULTS_DIR / code_id
+    if not results_path.exists():
+        return jsonify({"error": "Code ID not found"}), 404
+
+    try:
+        lines = ResultsProcessor(results_path).iter_export(export_format, id_prefix=f"{code_id}:")
+    except FileNotFoundError:
+        return jsonify({"error": "Analysis results not found, run /call_graph first"}), 404
+
+    return Response(lines, mimetype=EXPORT_FORMATS[export_format]), 200
+
+
+@app.route("/search", methods=["GET"])
+def search() -> tuple[Response, int]:
+    """Search function signatures and bodies of analyzed code.
+
+    The search uses the trigram index built during analysis to narrow down the
+    candidate functions before verifying them against their full text.
+
+    Query parameters:
+        - q: Substring or regular expression to search for (required)
+        - regex: "true" or "1" to interpret q as a regular expression
+        - code_id: Restrict the search to one code ID; all analyzed code IDs are
+          searched if omitted
+        - limit: Maximum number of matches per code ID (default 100)
+
+    Returns:
+        - 200: Success response with "matches", a mapping of code IDs to matching
+          functions (name, file, lineNumber, signature)
+        - 400: Bad request (missing query, invalid regular expression, code ID or limit)
+        - 404: Code ID or search index not found
+    """
+    query = request.args.get("q", "")
+    if not query:
+        return jsonify({"error": "No query provided"}), 400
+
+    regex = request.args.get("regex", "").lower() in ("1", "true")
+    try:
+        limit = int(request.args.get("limit", 100))
+    except ValueError:
+        return jsonify({"error": "Limit must be an integer"}), 400
+    if limit <= 0:
+        return jsonify({"error": "Limit must be positive"}), 400
+
+    code_id = request.args.get("code_id")
+    if code_id is not None:
+        error = _code_id_error(code_id)
+        if error:
+            return error
+        results_paths = [RESULTS_DIR / code_id]
+        if not results_paths[0].exists():
+            return jsonify({"error": "Code ID not found"}), 404
+    else:
+        results_paths = sorted(path for path in RESULTS_DIR.iterdir() if (path / "search_index.json").exists())
+
+    matches = {}
+    try:
+        for results_path in results_paths:
+            found = ResultsProcessor(results_path).search_functions(query, regex, limit)
+            if found:
+                matches[results_path.name] = found
+    except FileNotFoundError:
+        return jsonify({"error": "Search index not found, run /call_graph first"}), 404
+    except re.error as e:
+        return jsonify({"error": f"Invalid regular expression: {str(e)}"}), 400
+
+    return jsonify({"matches": matches}), 200
+
+
+@app.route("/federation", methods=["GET"])
+def get_federation() -> tuple[Response, int]:
+    """List the code IDs registered with the federated index.
+
+    Returns:
+        - 200: Success response with "code_ids"
+    """
+    return jsonify({"code_ids": FederatedIndex(RESULTS_DIR).code_ids()}), 200
+
+
+@app.route("/federation/<code_id>", methods=["POST", "DELETE"])
+def update_federation(code_id: str) -> tuple[Response, int]:
+    """Register analyzed code with the federated index, or remove it again.
+
+    Registered code exports its functions, so that calls from other registered
+    code IDs to functions of the same name are linked to it.
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+
+    Returns:
+        - 200: Success response; POST includes the number of "exported" functions
+        - 400: Invalid code ID
+        - 404: Code ID not found, not analyzed yet, or (DELETE) not registered
+    """
+    error = _code_id_error(code_id)
+    if error:
+        return error
+
+    federation = FederatedIndex(RESULTS_DIR)
+    if request.method == "DELETE":
+        if not federation.unregister(code_id):
+            return jsonify({"error": "Code ID not registered"}), 404
+        return jsonify({"message": "Code ID unregistered"}), 200
+
+    if not (RESULTS_DIR / code_id).exists():
+        return jsonify({"error": "Code ID not found"}), 404
+    try:
+        exported = federation.register(code_id)
+    except FileNotFoundError:
+        return jsonify({"error": "Analysis results not found, run /call_graph first"}), 404
+    return jsonify({"message": "Code ID registered", "exported": exported}), 200
+
+
+@app.route("/federation/<code_id>/links", methods=["GET"])
+def get_federation_links(code_id: str) -> tuple[Response, int]:
+    """Link the calls to functions that analyzed code does not define to other registered code IDs.
+
+    Args:
+        code_id: The unique identifier of the uploaded code (SHA-512 hash)
+
+    Returns:
+        - 200: Success response with "links", the unresolved calls (method, name,
+          file, lineNumber) with the registered code IDs defining the callee
+        - 400: Invalid code ID
+        - 404: Code ID not found
+    """
+    error = _code_id_error(code_id)
+    if error:
+        return error
+
+    if not (RESULTS_DIR / code_id).exists():
+        return jsonify({"error": "Code ID not found"}), 404
+    return jsonify({"links": FederatedIndex(RESULTS_DIR).links(code_id)}), 200
+
+
+@app.route("/federation/reachability", methods=["POST"])
+def get_federation_reachability() -> tuple[Response, int]:
+    """Answer reachability queries across registered code IDs.
+
+    Request:
+        - Method: POST
+        - Content-Type: application/json
+        - Body: {"sources": [{"code_id": ..., "function": ...}, ...],
+                 "targets": [{"code_id": ..., "function": ...}, ...]}
+
+    Returns:
+        - 200: Success response with "reachable", a list of {"source", "targets"}
+          entries with the targets reachable from each source
+        - 400: Bad request (missing or malformed sources/targets, or an invalid code ID)
+        - 404: A code ID is not registered, or a visited code ID has not been analyzed
+    """
+    body = request.get_json(silent=True) or {}
+    try:
+        sources = [(ref["code_id"], ref["function"]) for ref in body["sources"]]
+        targets = [(ref["code_id"], ref["function"]) for ref in body["targets"]]
+    except (KeyError, TypeError):
+        return jsonify({"error": "Body must contain 'sources' and 'targets' lists of {code_id, function}"}), 400
+    if not all(isinstance(value, str) for ref in sources + targets for value in ref):
+        return jsonify({"error": "The code_id and function of sources and targets must be strings"}), 400
+
+    error = _code_id_error(*(code_id for code_id, _ in sources + targets))
+    if error:
+        return error
+
+    federation = FederatedIndex(RESULTS_DIR)
+    unregistered = sorted({code_id for code_id, _ in sources + targets} - set(federation.code_ids()))
+    if unregistered:
+        return jsonify({"error": f"Code IDs not registered: {', '.join(unregistered)}"}), 404
+
+    try:
+        reachable = federation.reachable(sources, targets)
+    except FileNotFoundError as e:
+        return jsonify({"error": str(e)}), 404
+
+    return (
+        jsonify(
+            {
+                "reachable": [
+                    {
+                        "source": {"code_id": source[0], "function": source[1]},
+                        "targets": [{"code_id": code_id, "function": function} for code_id, function in found],
+                    }
+                    for source, found in reachable.items()
+                ]
+            }
+        ),
+        200,
+    )
+
+
+@app.route("/metrics", methods=["GET"])
+def get_metrics() -> tuple[Response, int]:
+    """Get phase timings, output sizes and resource usage in Prometheus text format.
+
+    Returns:
+        - 200: Metrics of all analyses run by this server process
+    """
+    return Response(METRICS.render(), mimetype="text/plain; version=0.0.4"), 200
+
+
 @click.command()
 @click.option("--port", default=3003, help="Port to run the server on")
 @click.option("--debug", is_flag=True, default=False, help="Enable debug mode")
 @click.option("--host", default="127.0.0.1", help="Host to bind the server to")
-def main(port: int, debug: bool, host: str) -> None:
+@click.option(
+    "--backend",
+    type=click.Choice(["docker", "offline"]),
+    default=None,
+    help="Run Joern in Docker, or replay or synthesize its output offline [default: from settings.py]",
+)
+def main(port: int, debug: bool, host: str, backend: Optional[str]) -> None:
     """Run the Flask server."""
+    app.config["BACKEND"] = backend
     app.run(host=host, port=port, debug=debug)
 
 
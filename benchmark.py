@@ -0,0 +1,405 @@
+#! /usr/bin/env python3
+
+"""
+Performance Regression Benchmark
+
+This module benchmarks the analysis pipeline and detects performance regressions.
+
+Every codebase (the example projects in test_code/ and optionally generated codebases,
+see generate_test_code.py) is analyzed through the command line interface and/or the
+REST API, with warmup runs followed by measured repetitions. For each case the
+benchmark records:
+- Wall time of the analysis
+- Time of every analysis phase, from the timings.json of the run
+- Peak RSS of the Python process (the CLI process, or the API server via /metrics)
+- Peak memory of the Joern container
+- Total size of the output files
+
+Times are the median and memory peaks the maximum over the repetitions. Each benchmark
+run is appended to a JSON history file and compared with the previous run in the
+history; the benchmark fails when a metric regresses by more than the threshold.
+
+Dependencies:
+    - Docker (for running Joern)
+    - Python 3.x
+    - Required Python packages: click, loguru, requests
+"""
+
+import hashlib
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+from datetime import datetime, timezone
+from functools import partial
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, Tuple, cast
+
+import click
+import requests
+from loguru import logger
+
+from generate_test_code import GeneratorParameters, generate_codebase
+from simple_rest_client import create_zip_from_directory
+from utils.file_handler import FileHandler
+
+REPO_DIR = Path(__file__).parent
+
+# Example projects benchmarked by default
+DEFAULT_CODEBASES = ["test_code/simple", "test_code/complex", "test_code/more_complex"]
+
+# Regressions in times below this many seconds are treated as noise
+MIN_TIME_DELTA = 0.1
+
+
+def _git_commit() -> str:
+    """Get the current git commit of the repository, or an empty string."""
+    result = subprocess.run(["git", "rev-parse", "HEAD"], cwd=REPO_DIR, capture_output=True, text=True)
+    return result.stdout.strip() if result.returncode == 0 else ""
+
+
+def _cli_results_dir(codebase: Path) -> Path:
+    """Get the results directory the CLI uses for a codebase."""
+    code_path_abs_hash = hashlib.sha512(str(codebase.resolve()).encode()).hexdigest()
+    return Path.cwd() / "results" / code_path_abs_hash
+
+
+def _read_timings(results_dir: Path) -> Dict[str, Any]:
+    """Read the timings.json of an analysis run, or empty timings if there is none."""
+    timings_file = results_dir / "timings.json"
+    if not timings_file.exists():
+        return {}
+    return cast(Dict[str, Any], FileHandler.read_json(timings_file))
+
+
+def run_cli(codebase: Path, backend: str) -> Dict[str, Any]:
+    """Analyze a codebase once through the command line interface.
+
+    Args:
+        codebase (Path): The codebase to analyze
+        backend (str): "docker" or "offline"
+
+    Returns:
+        Dict[str, Any]: Measurements of the run
+
+    Raises:
+        RuntimeError: If the analysis fails
+    """
+    # The log goes to a file, a pipe could fill up while waiting for the process
+    with tempfile.TemporaryFile() as log:
+        start = time.perf_counter()
+        process = subprocess.Popen(
+            [sys.executable, str(REPO_DIR / "joern_analyzer.py"), "--backend", backend, str(codebase)],
+            stdout=log,
+            stderr=log,
+        )
+        # wait4 reports the resource usage of this child only
+        _, status, usage = os.wait4(process.pid, 0)
+        wall = time.perf_counter() - start
+        if os.waitstatus_to_exitcode(status) != 0:
+            log.seek(0)
+            raise RuntimeError(f"Analysis of {codebase} failed: {log.read().decode(errors='replace')[-2000:]}")
+
+    timings = _read_timings(_cli_results_dir(codebase))
+    return {
+        "wall_seconds": wall,
+        "phases": timings.get("phases", {}),
+        # ru_maxrss is reported in KiB on Linux and in bytes on macOS
+        "python_peak_rss_bytes": usage.ru_maxrss * (1 if sys.platform == "darwin" else 1024),
+        "container_memory_peak_bytes": timings.get("resources", {}).get("container_memory_peak_bytes"),
+        "output_bytes": sum(timings.get("sizes", {}).values()),
+    }
+
+
+def _api_peak_rss(api_url: str) -> Optional[int]:
+    """Get the peak RSS of the API server from its /metrics endpoint."""
+    try:
+        response = requests.get(f"{api_url}/metrics", timeout=10)
+        for line in response.text.splitlines():
+            if line.startswith("process_max_resident_memory_bytes "):
+                return int(float(line.split()[1]))
+    except requests.RequestException as e:
+        logger.warning(f"Failed to read API metrics: {str(e)}")
+    return None
+
+
+def upload_codebase(codebase: Path, api_url: str) -> str:
+    """Upload a codebase to the API.
+
+    Args:
+        codebase (Path): The codebase to upload
+        api_url (str): Base URL of the API
+
+    Returns:
+        str: The code ID
+
+    Raises:
+        RuntimeError: If the upload fails
+    """
+    with tempfile.TemporaryDirectory() as temp_dir:
+        zip_path = Path(temp_dir) / "code.zip"
+        if not create_zip_from_directory(codebase, zip_path):
+            raise RuntimeError(f"Failed to zip {codebase}")
+        with open(zip_path, "rb") as f:
+            response = requests.post(f"{api_url}/upload_code", files={"file": f})
+    if response.status_code != 200:
+        raise RuntimeError(f"Upload of {codebase} failed: {response.text}")
+    return cast(str, response.json()["code_id"])
+
+
+def run_api(code_id: str, api_url: str, api_results_dir: Path) -> Dict[str, Any]:
+    """Analyze uploaded code once through the REST API.
+
+    Args:
+        code_id (str): ID of the uploaded code
+        api_url (str): Base URL of the API
+        api_results_dir (Path): Results directory of the API server, for timings.json
+
+    Returns:
+        Dict[str, Any]: Measurements of the run
+
+    Raises:
+        RuntimeError: If the analysis fails
+    """
+    start = time.perf_counter()
+    response = requests.get(f"{api_url}/call_graph/{code_id}")
+    wall = time.perf_counter() - start
+    if response.status_code != 200:
+        raise RuntimeError(f"Analysis of {code_id} failed: {response.text}")
+
+    timings = _read_timings(api_results_dir / code_id)
+    return {
+        "wall_seconds": wall,
+        "phases": timings.get("phases", {}),
+        "python_peak_rss_bytes": _api_peak_rss(api_url),
+        "container_memory_peak_bytes": timings.get("resources", {}).get("container_memory_peak_bytes"),
+        "output_bytes": sum(timings.get("sizes", {}).values()),
+        "response_bytes": len(response.content),
+    }
+
+
+def aggregate(runs: List[Dict[str, Any]]) -> Dict[str, Any]:
+    """Aggregate the measured repetitions of a case.
+
+    Args:
+        runs (List[Dict[str, Any]]): Measurements of each repetition
+
+    Returns:
+        Dict[str, Any]: Median times, maximum memory peaks and output sizes of the
+            last repetition, with the individual wall times in "wall_seconds_runs"
+    """
+    phases = sorted({phase for run in runs for phase in run["phases"]})
+    result: Dict[str, Any] = {
+        "wall_seconds": statistics.median(run["wall_seconds"] for run in runs),
+        "wall_seconds_runs": [run["wall_seconds"] for run in runs],
+        "phases": {phase: statistics.median(run["phases"].get(phase, 0.0) for run in runs) for phase in phases},
+    }
+    for key in ("python_peak_rss_bytes", "container_memory_peak_bytes"):
+        values = [run[key] for run in runs if run.get(key) is not None]
+        result[key] = max(values) if values else None
+    for key in ("output_bytes", "response_bytes"):
+        if key in runs[-1]:
+            result[key] = runs[-1][key]
+    return result
+
+
+def flatten_metrics(case: Dict[str, Any]) -> Dict[str, float]:
+    """Flatten the metrics of an aggregated case for comparison.
+
+    Args:
+        case (Dict[str, Any]): Aggregated case, see aggregate()
+
+    Returns:
+        Dict[str, float]: Metric values by name, phases as "phase:<name>"
+    """
+    metrics = {f"phase:{phase}": seconds for phase, seconds in case.get("phases", {}).items()}
+    for key, value in case.items():
+        if isinstance(value, (int, float)) and not isinstance(value, bool):
+            metrics[key] = value
+    return metrics
+
+
+def find_regressions(
+    current: Dict[str, Dict[str, Any]], baseline: Dict[str, Dict[str, Any]], threshold: float
+) -> List[Tuple[str, str, float, float]]:
+    """Compare the cases of a benchmark run with a baseline run.
+
+    A metric regresses if it grew by more than the threshold relative to the baseline.
+    Time metrics must additionally grow by more than MIN_TIME_DELTA seconds, so that
+    fast phases do not fail the benchmark because of noise.
+
+    Args:
+        current (Dict[str, Dict[str, Any]]): Aggregated cases of the current run
+        baseline (Dict[str, Dict[str, Any]]): Aggregated cases of the baseline run
+        threshold (float): Allowed relative growth, e.g. 0.2 for 20%
+
+    Returns:
+        List[Tuple[str, str, float, float]]: Case, metric, baseline and current value
+            of each regression
+    """
+    regressions = []
+    for case_name, case in current.items():
+        if case_name not in baseline:
+            continue
+        baseline_metrics = flatten_metrics(baseline[case_name])
+        for metric, value in flatten_metrics(case).items():
+            old = baseline_metrics.get(metric)
+            if not old or value <= old * (1 + threshold):
+                continue
+            is_time = metric.startswith("phase:") or metric.endswith("_seconds")
+            if is_time and value - old <= MIN_TIME_DELTA:
+                continue
+            regressions.append((case_name, metric, old, value))
+    return regressions
+
+
+def _parse_generated(spec: str) -> GeneratorParameters:
+    """Parse a generated codebase spec "<files>x<functions per file>[_s<seed>]"."""
+    shape, _, seed = spec.partition("_s")
+    files, _, functions_per_file = shape.partition("x")
+    try:
+        return GeneratorParameters(files=int(files), functions_per_file=int(functions_per_file), seed=int(seed or 0))
+    except ValueError:
+        raise click.BadParameter(f"Expected <files>x<functions per file>[_s<seed>], got {spec}") from None
+
+
+@click.command()
+@click.option(
+    "--codebase",
+    "codebases",
+    multiple=True,
+    type=click.Path(exists=True, file_okay=False, dir_okay=True, path_type=Path),
+    help="Codebase to benchmark, may be repeated [default: the example projects in test_code/]",
+)
+@click.option(
+    "--generated",
+    multiple=True,
+    help="Generated codebase to benchmark as <files>x<functions per file>[_s<seed>], e.g. 100x10, may be repeated",
+)
+@click.option("--mode", type=click.Choice(["cli", "api", "both"]), default="cli", show_default=True)
+@click.option(
+    "--backend",
+    type=click.Choice(["docker", "offline"]),
+    default="docker",
+    show_default=True,
+    help="Backend of the CLI runs; start the API with the same --backend",
+)
+@click.option("--warmup", default=1, show_default=True, help="Unmeasured runs per case")
+@click.option("--repetitions", default=3, show_default=True, help="Measured runs per case")
+@click.option("--api-url", default="http://localhost:3003", show_default=True, help="Base URL of the API")
+@click.option(
+    "--api-results-dir",
+    type=click.Path(file_okay=False, dir_okay=True, path_type=Path),
+    default=Path("results"),
+    show_default=True,
+    help="Results directory of the API server",
+)
+@click.option(
+    "--history",
+    type=click.Path(dir_okay=False, path_type=Path),
+    default=Path("results") / "benchmark_history.json",
+    show_default=True,
+    help="JSON history of benchmark runs",
+)
+@click.option("--threshold", default=0.2, show_default=True, help="Allowed relative regression against the baseline")
+@click.option("--save-results", is_flag=True, default=False, help="Save API responses as <codebase>_results.json")
+def main(
+    codebases: Tuple[Path, ...],
+    generated: Tuple[str, ...],
+    mode: str,
+    backend: str,
+    warmup: int,
+    repetitions: int,
+    api_url: str,
+    api_results_dir: Path,
+    history: Path,
+    threshold: float,
+    save_results: bool,
+) -> None:
+    """
+    Benchmark the analysis of codebases and fail on performance regressions.
+
+    The baseline is the previous run with the same backend in the history file. The
+    offline backend measures the Python side of the pipeline only. Exits with status 1 if a
+    metric regressed by more than the threshold, and with status 2 if an analysis failed.
+    """
+    targets = list(codebases) or ([] if generated else [REPO_DIR / path for path in DEFAULT_CODEBASES])
+    for spec in generated:
+        params = _parse_generated(spec)
+        output = REPO_DIR / "test_code" / "generated" / f"{params.files}x{params.functions_per_file}_s{params.seed}"
+        manifest = generate_codebase(output, params)
+        logger.info(f"Generated {manifest['functions']} functions in {output}")
+        targets.append(output)
+
+    modes = ["cli", "api"] if mode == "both" else [mode]
+    cases: Dict[str, Dict[str, Any]] = {}
+    try:
+        for codebase in targets:
+            for case_mode in modes:
+                case_name = f"{case_mode}:{os.path.relpath(codebase.resolve(), REPO_DIR.resolve())}"
+                run: Callable[[], Dict[str, Any]]
+                if case_mode == "cli":
+                    run = partial(run_cli, codebase, backend)
+                else:
+                    code_id = upload_codebase(codebase, api_url)
+                    run = partial(run_api, code_id, api_url, api_results_dir)
+
+                for _ in range(warmup):
+                    run()
+                runs = []
+                for repetition in range(repetitions):
+                    runs.append(run())
+                    logger.info(f"{case_name} run {repetition + 1}/{repetitions}: {runs[-1]['wall_seconds']:.2f}s")
+                cases[case_name] = aggregate(runs)
+
+                if save_results and case_mode == "api":
+                    response = requests.get(f"{api_url}/call_graph/{code_id}")
+                    FileHandler.write_json(response.json(), codebase.parent / f"{codebase.name}_results.json")
+    except (RuntimeError, requests.RequestException) as e:
+        logger.error(f"Benchmark failed: {str(e)}")
+        sys.exit(2)
+
+    runs_history: List[Dict[str, Any]] = (
+        cast(List[Dict[str, Any]], FileHandler.read_json(history)) if history.exists() else []
+    )
+    same_backend = [entry for entry in runs_history if entry.get("backend", "docker") == backend]
+    baseline = same_backend[-1]["cases"] if same_backend else {}
+    regressions = find_regressions(cases, baseline, threshold)
+
+    runs_history.append(
+        {
+            "timestamp": datetime.now(timezone.utc).isoformat(),
+            "commit": _git_commit(),
+            "host": platform.node(),
+            "backend": backend,
+            "warmup": warmup,
+            "repetitions": repetitions,
+            "cases": cases,
+        }
+    )
+    history.parent.mkdir(parents=True, exist_ok=True)
+    FileHandler.write_json(runs_history, history)
+
+    click.echo(f"{'case':<50} {'wall [s]':>10} {'baseline [s]':>13} {'python RSS [MiB]':>17} {'container [MiB]':>16}")
+    for case_name, case in cases.items():
+        old = baseline.get(case_name, {}).get("wall_seconds")
+        python_rss = case["python_peak_rss_bytes"]
+        container = case["container_memory_peak_bytes"]
+        click.echo(
+            f"{case_name:<50} {case['wall_seconds']:>10.2f} {(f'{old:.2f}' if old else '-'):>13}"
+            f" {(f'{python_rss / 2**20:.0f}' if python_rss else '-'):>17}"
+            f" {(f'{container / 2**20:.0f}' if container else '-'):>16}"
+        )
+
+    if regressions:
+        for case_name, metric, old, value in regressions:
+            logger.error(f"Regression in {case_name} {metric}: {old:.4g} -> {value:.4g} (+{value / old - 1:.0%})")
+        sys.exit(1)
+    logger.info(f"No regressions beyond {threshold:.0%}, history saved to {history}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,202 @@
+"""Federated Index Module
+
+This module links the call graphs of separately analyzed code IDs, e.g. libraries
+that call into each other, without analyzing them together.
+
+Every analysis records the calls to functions it does not define itself
+(unresolved_calls.json). Code IDs registered with the federated index export their
+defined functions, and an unresolved callee in one code ID is linked to every other
+registered code ID that defines a function of the same name.
+
+Cross code ID reachability is answered with the per code ID reachability indexes:
+a query walks from the reachable callers of linked unresolved calls into the code IDs
+that define the callees, so no merged call graph is ever built.
+
+The registry is stored as federation.json in the results directory.
+"""
+
+import threading
+from pathlib import Path
+from typing import Any, Dict, List, Set, Tuple, cast
+
+from results_processor import ResultsProcessor
+from utils.file_handler import FileHandler
+from utils.reachability import ReachabilityIndex
+
+# A function in a specific code ID
+FunctionRef = Tuple[str, str]
+
+
+class FederatedIndex:
+    """A registry of analyzed code IDs and the functions they export.
+
+    Attributes:
+        results_dir (Path): Directory containing one results directory per code ID
+        registry_file (Path): Path to the persisted registry
+        file_handler (FileHandler): Instance of FileHandler for file operations
+    """
+
+    # Serializes updates of the registry file across request threads
+    _lock = threading.Lock()
+
+    def __init__(self, results_dir: Path):
+        """Initialize the federated index.
+
+        Args:
+            results_dir (Path): Directory containing one results directory per code ID
+        """
+        self.results_dir = results_dir
+        self.registry_file = results_dir / "federation.json"
+        self.file_handler = FileHandler()
+
+    def _load_registry(self) -> Dict[str, Any]:
+        """Load the registry, or an empty one if none has been written yet.
+
+        Returns:
+            Dict[str, Any]: Registry with "code_ids" (registered code IDs) and
+                "exports" (code IDs defining each function name)
+        """
+        if not self.registry_file.exists():
+            return {"code_ids": [], "exports": {}}
+        return cast(Dict[str, Any], self.file_handler.read_json(self.registry_file))
+
+    def code_ids(self) -> List[str]:
+        """Get the registered code IDs.
+
+        Returns:
+            List[str]: Sorted registered code IDs
+        """
+        return cast(List[str], self._load_registry()["code_ids"])
+
+    def register(self, code_id: str) -> int:
+        """Register an analyzed code ID and export its functions.
+
+        Registering a code ID again refreshes its exports.
+
+        Args:
+            code_id (str): The code ID to register
+
+        Returns:
+            int: Number of exported functions
+
+        Raises:
+            FileNotFoundError: If the code ID has no cleaned results
+        """
+        functions_file = self.results_dir / code_id / "functions_clean.json"
+        if not functions_file.exists():
+            raise FileNotFoundError(f"Cleaned functions not found: {functions_file}")
+        names = {func["name"] for func in self.file_handler.read_json(functions_file) if func.get("name")}
+        names.discard("<global>")
+
+        with self._lock:
+            registry = self._load_registry()
+            self._remove_exports(registry, code_id)
+            for name in names:
+                registry["exports"].setdefault(name, []).append(code_id)
+                registry["exports"][name].sort()
+            registry["code_ids"] = sorted(set(registry["code_ids"]) | {code_id})
+            self.file_handler.write_json(registry, self.registry_file)
+
+        return len(names)
+
+    def unregister(self, code_id: str) -> bool:
+        """Remove a code ID and its exports from the registry.
+
+        Args:
+            code_id (str): The code ID to remove
+
+        Returns:
+            bool: True if the code ID was registered
+        """
+        with self._lock:
+            registry = self._load_registry()
+            if code_id not in registry["code_ids"]:
+                return False
+            self._remove_exports(registry, code_id)
+            registry["code_ids"].remove(code_id)
+            self.file_handler.write_json(registry, self.registry_file)
+        return True
+
+    @staticmethod
+    def _remove_exports(registry: Dict[str, Any], code_id: str) -> None:
+        """Remove the exports of a code ID from a loaded registry in place."""
+        exports = registry["exports"]
+        for name in [name for name, code_ids in exports.items() if code_id in code_ids]:
+            exports[name].remove(code_id)
+            if not exports[name]:
+                del exports[name]
+
+    def _unresolved_calls(self, code_id: str) -> List[Dict[str, Any]]:
+        """Load the unresolved calls of a code ID."""
+        return self.file_handler.read_json(self.results_dir / code_id / "unresolved_calls.json")
+
+    def links(self, code_id: str) -> List[Dict[str, Any]]:
+        """Link the unresolved calls of a code ID to their definitions in other code IDs.
+
+        Args:
+            code_id (str): The code ID whose unresolved calls are linked
+
+        Returns:
+            List[Dict[str, Any]]: The unresolved calls (method, name, file, lineNumber),
+                each with "definitions", the other registered code IDs defining the callee
+        """
+        exports = self._load_registry()["exports"]
+        return [
+            {**call, "definitions": [other for other in exports.get(call["name"], []) if other != code_id]}
+            for call in self._unresolved_calls(code_id)
+        ]
+
+    def reachable(self, sources: List[FunctionRef], targets: List[FunctionRef]) -> Dict[FunctionRef, List[FunctionRef]]:
+        """Answer reachability queries across code IDs.
+
+        Args:
+            sources (List[FunctionRef]): ``(code_id, function)`` pairs to start from
+            targets (List[FunctionRef]): ``(code_id, function)`` pairs to look for
+
+        Returns:
+            Dict[FunctionRef, List[FunctionRef]]: Sorted reachable targets for each source
+
+        Raises:
+            FileNotFoundError: If a visited code ID has no reachability index
+        """
+        exports = self._load_registry()["exports"]
+        indexes: Dict[str, ReachabilityIndex] = {}
+        portals: Dict[str, Dict[str, List[FunctionRef]]] = {}
+
+        def load(code_id: str) -> Tuple[ReachabilityIndex, Dict[str, List[FunctionRef]]]:
+            # Map each caller of a linked unresolved call to the definitions it calls into
+            if code_id not in indexes:
+                indexes[code_id] = ResultsProcessor(self.results_dir / code_id).load_reachability_index()
+                callers: Dict[str, List[FunctionRef]] = {}
+                for call in self._unresolved_calls(code_id):
+                    for other in exports.get(call["name"], []):
+                        if other != code_id:
+                            callers.setdefault(call["method"], []).append((other, call["name"]))
+                portals[code_id] = callers
+            return indexes[code_id], portals[code_id]
+
+        targets_by_code_id: Dict[str, Set[str]] = {}
+        for code_id, function in targets:
+            targets_by_code_id.setdefault(code_id, set()).add(function)
+
+        result: Dict[FunctionRef, List[FunctionRef]] = {}
+        for source in sources:
+            visited: Set[FunctionRef] = {source}
+            pending: List[FunctionRef] = [source]
+            found: Set[FunctionRef] = set()
+
+            while pending:
+                code_id, function = pending.pop()
+                index, callers = load(code_id)
+                wanted = targets_by_code_id.get(code_id, set()) | callers.keys()
+                for reached in index.reachable_targets([function], wanted).get(function, []):
+                    if reached in targets_by_code_id.get(code_id, ()):
+                        found.add((code_id, reached))
+                    for definition in callers.get(reached, []):
+                        if definition not in visited:
+                            visited.add(definition)
+                            pending.append(definition)
+
+            result[source] = sorted(found)
+
+        return result
@@ -0,0 +1,349 @@
+#! /usr/bin/env python3
+
+"""
+Synthetic C Codebase Generator
+
+This module generates deterministic synthetic C codebases for benchmarking the
+analysis pipeline at scales the example projects in test_code/ cannot reach.
+
+The shape of the generated code is controlled by:
+- The number of source files and functions per file
+- The call fan-out of every function
+- The recursion density, i.e. the fraction of functions with a self or back call
+- The header depth, i.e. the length of the include chain of every source file
+- The body size, i.e. the number of statements per function
+- The sink ratio, i.e. the fraction of functions calling a system function
+
+Forward calls always go to functions with a higher global index, so the call graph is
+a DAG apart from the recursive back calls. main() calls the first function of every
+file. The same parameters and seed always produce byte-identical output, and a
+manifest.json with the parameters and function and call counts is written next to
+the sources. synthesize_results() produces the functions.json and call_graph.json
+Joern writes for a generated codebase without writing or parsing the code, which the
+offline backend uses as its analysis output.
+
+Dependencies:
+    - Python 3.x
+    - Required Python packages: click, loguru
+"""
+
+import random
+import re
+import shutil
+from pathlib import Path
+from typing import Any, Dict, List, NamedTuple, Set, Tuple
+
+import click
+from loguru import logger
+
+from utils.file_handler import FileHandler
+
+# System functions called by sink functions
+SINK_FUNCTIONS = ["strcpy", "memcpy", "strlen", "printf"]
+
+# Call of a function in a generated line
+CALL_PATTERN = re.compile(r"(\w+)\(")
+
+# Number of source files per directory, to keep directories small for large codebases
+FILES_PER_DIRECTORY = 256
+
+
+class GeneratorParameters(NamedTuple):
+    """Parameters of a generated codebase."""
+
+    files: int = 10
+    functions_per_file: int = 10
+    fan_out: int = 3
+    recursion_density: float = 0.05
+    header_depth: int = 2
+    body_size: int = 5
+    sink_ratio: float = 0.05
+    seed: int = 0
+
+
+def function_name(index: int, params: GeneratorParameters) -> str:
+    """Get the name of a function by its global index."""
+    return f"f_{index // params.functions_per_file}_{index % params.functions_per_file}"
+
+
+def source_path(file: int, extension: str) -> Path:
+    """Get the path of a generated source or header file relative to the codebase root."""
+    return Path(f"src/d{file // FILES_PER_DIRECTORY:04d}/file_{file}{extension}")
+
+
+def _plan_calls(params: GeneratorParameters, rng: random.Random) -> List[List[int]]:
+    """Choose the callees of every function.
+
+    Returns:
+        List[List[int]]: Global indexes of the callees of each function
+    """
+    total = params.files * params.functions_per_file
+    calls: List[List[int]] = []
+    for index in range(total):
+        remaining = total - index - 1
+        callees = sorted(rng.sample(range(index + 1, total), min(params.fan_out, remaining))) if remaining else []
+        if rng.random() < params.recursion_density:
+            # Self recursion or a back call closing a cycle through an earlier function
+            callees.append(index if index == 0 or rng.random() < 0.5 else rng.randrange(index))
+        calls.append(callees)
+    return calls
+
+
+def _write_headers(root: Path, params: GeneratorParameters) -> None:
+    """Write the shared include chain used to model header depth."""
+    include_dir = root / "include"
+    include_dir.mkdir(parents=True, exist_ok=True)
+    for level in range(params.header_depth):
+        lines = [f"#ifndef LEVEL_{level}_H", f"#define LEVEL_{level}_H", ""]
+        if level + 1 < params.header_depth:
+            lines += [f'#include "level_{level + 1}.h"', ""]
+        else:
+            lines += ["#include <stdio.h>", "#include <string.h>", ""]
+        lines += [f"typedef int level_{level}_t;", f"#define LEVEL_{level}_VALUE {level + 1}", "", "#endif", ""]
+        FileHandler.write_text("\n".join(lines), include_dir / f"level_{level}.h")
+
+
+def _function_body(
+    index: int, callees: List[int], params: GeneratorParameters, rng: random.Random
+) -> Tuple[List[str], bool]:
+    """Generate the lines of one function definition and whether it calls a system function."""
+    lines = [f"unsigned {function_name(index, params)}(unsigned x, int depth) {{", "    unsigned acc = x;"]
+    for statement in range(params.body_size):
+        lines.append(f"    acc = acc * {rng.randint(2, 9)}u + {statement}u;")
+    # Bound the call depth so that running the generated program terminates quickly
+    for callee in callees:
+        lines.append(f"    if (depth > 0) acc += {function_name(callee, params)}(acc, depth - 1);")
+    calls_sink = rng.random() < params.sink_ratio
+    if calls_sink:
+        sink = rng.choice(SINK_FUNCTIONS)
+        if sink == "printf":
+            lines.append('    printf("%u\\n", acc);')
+        elif sink == "strlen":
+            lines.append('    acc += (unsigned)strlen("sink");')
+        elif sink == "strcpy":
+            lines += ["    char buffer[16];", '    strcpy(buffer, "sink");']
+        else:
+            lines += ["    char buffer[16];", '    memcpy(buffer, "sink", 5);']
+    lines += ["    return acc;", "}", ""]
+    return lines, calls_sink
+
+
+def _source_file(
+    file: int, calls: List[List[int]], params: GeneratorParameters, rng: random.Random
+) -> Tuple[List[str], List[int], int]:
+    """Generate the lines of one source file.
+
+    Returns:
+        Tuple[List[str], List[int], int]: The lines, the index of the first line of
+            each function in the file and the number of functions calling a system function
+    """
+    fpf = params.functions_per_file
+    functions = range(file * fpf, (file + 1) * fpf)
+    called_files = sorted({callee // fpf for index in functions for callee in calls[index]} - {file})
+
+    lines = [f'#include "file_{file}.h"']
+    lines += [f'#include "../d{other // FILES_PER_DIRECTORY:04d}/file_{other}.h"' for other in called_files]
+    lines += ["#include <stdio.h>", "#include <string.h>", ""]
+    starts = []
+    sink_calls = 0
+    for index in functions:
+        body, calls_sink = _function_body(index, calls[index], params, rng)
+        starts.append(len(lines))
+        lines += body
+        sink_calls += calls_sink
+    return lines, starts, sink_calls
+
+
+def _main_file(params: GeneratorParameters) -> List[str]:
+    """Generate the lines of main.c, which calls the first function of every file."""
+    fpf = params.functions_per_file
+    lines = [f'#include "{source_path(file, ".h").as_posix()}"' for file in range(params.files)]
+    lines += ["", "int main(void) {", "    unsigned acc = 0;"]
+    lines += [f"    acc += {function_name(file * fpf, params)}(acc, 2);" for file in range(params.files)]
+    lines += ["    return acc == 42;", "}", ""]
+    return lines
+
+
+def generate_codebase(output_dir: Path, params: GeneratorParameters) -> Dict[str, Any]:
+    """Generate a synthetic C codebase.
+
+    Any existing content of the output directory is replaced.
+
+    Args:
+        output_dir (Path): Directory to write the codebase to
+        params (GeneratorParameters): Shape of the codebase
+
+    Returns:
+        Dict[str, Any]: The manifest, with the parameters and the number of files,
+            functions, calls between generated functions and calls to system functions
+    """
+    if output_dir.exists():
+        shutil.rmtree(output_dir)
+    output_dir.mkdir(parents=True)
+
+    rng = random.Random(params.seed)
+    calls = _plan_calls(params, rng)
+    _write_headers(output_dir, params)
+
+    fpf = params.functions_per_file
+    sink_calls = 0
+    for file in range(params.files):
+        functions = range(file * fpf, (file + 1) * fpf)
+
+        header = source_path(file, ".h")
+        (output_dir / header).parent.mkdir(parents=True, exist_ok=True)
+        guard = f"FILE_{file}_H"
+        header_lines = [f"#ifndef {guard}", f"#define {guard}", ""]
+        if params.header_depth:
+            header_lines += ['#include "../../include/level_0.h"', ""]
+        header_lines += [f"unsigned {function_name(index, params)}(unsigned x, int depth);" for index in functions]
+        header_lines += ["", "#endif", ""]
+        FileHandler.write_text("\n".join(header_lines), output_dir / header)
+
+        source_lines, _, file_sink_calls = _source_file(file, calls, params, rng)
+        sink_calls += file_sink_calls
+        FileHandler.write_text("\n".join(source_lines), output_dir / source_path(file, ".c"))
+
+    FileHandler.write_text("\n".join(_main_file(params)), output_dir / "main.c")
+
+    manifest = {
+        "parameters": params._asdict(),
+        "files": params.files + 1,
+        "functions": params.files * fpf + 1,
+        "calls": sum(len(callees) for callees in calls) + params.files,
+        "sink_calls": sink_calls,
+    }
+    FileHandler.write_json(manifest, output_dir / "manifest.json")
+    return manifest
+
+
+def _function_records(
+    file_name: str, lines: List[str], start: int, signature: str, known: Set[str]
+) -> Tuple[Dict[str, Any], List[Dict[str, Any]]]:
+    """Get the Joern method and call records of the function starting at a line.
+
+    Calls are recognized as known function names followed by "(", assignments by
+    " = " and compound additions by " += ".
+
+    Args:
+        file_name (str): Path of the source file relative to the codebase root
+        lines (List[str]): Lines of the source file
+        start (int): Index of the first line of the function
+        signature (str): Joern signature of the function
+        known (Set[str]): Names of the generated and system functions
+
+    Returns:
+        Tuple[Dict[str, Any], List[Dict[str, Any]]]: The method record and its call records
+    """
+    end = lines.index("}", start)
+    name = lines[start].split("(")[0].split()[-1]
+    calls = []
+    for line_number, line in enumerate(lines[start + 1 : end], start + 2):
+        callees = [callee for callee in CALL_PATTERN.findall(line) if callee in known]
+        if " += " in line:
+            callees.append("<operator>.assignmentPlus")
+        elif " = " in line:
+            callees.append("<operator>.assignment")
+        calls += [{"name": callee, "method": name, "file": file_name, "lineNumber": line_number} for callee in callees]
+    method = {
+        "name": name,
+        "file": file_name,
+        "lineNumber": start + 1,
+        "code": "\n".join(lines[start : end + 1]),
+        "signature": signature,
+    }
+    return method, calls
+
+
+def synthesize_results(params: GeneratorParameters) -> Tuple[List[Dict[str, Any]], List[Dict[str, Any]]]:
+    """Synthesize the functions.json and call_graph.json Joern writes for a generated codebase.
+
+    The codebase is generated in memory with the same random choices as
+    generate_codebase(), so the records match the code written for the same parameters.
+    Like Joern, the records include a <global> method per file, stub methods of the
+    operators and system functions, and calls of operators.
+
+    Args:
+        params (GeneratorParameters): Shape of the codebase
+
+    Returns:
+        Tuple[List[Dict[str, Any]], List[Dict[str, Any]]]: The function and call records
+    """
+    rng = random.Random(params.seed)
+    calls = _plan_calls(params, rng)
+    total = params.files * params.functions_per_file
+    known = {function_name(index, params) for index in range(total)} | set(SINK_FUNCTIONS)
+
+    functions: List[Dict[str, Any]] = []
+    call_records: List[Dict[str, Any]] = []
+
+    def add_file(file_name: str, lines: List[str], starts: List[int], signature: str) -> None:
+        for start in starts:
+            method, method_calls = _function_records(file_name, lines, start, signature, known)
+            functions.append(method)
+            call_records.extend(method_calls)
+        functions.append(
+            {"name": "<global>", "file": file_name, "lineNumber": 1, "code": "\n".join(lines[:3]), "signature": ""}
+        )
+
+    for file in range(params.files):
+        lines, starts, _ = _source_file(file, calls, params, rng)
+        add_file(source_path(file, ".c").as_posix(), lines, starts, "unsigned int(unsigned int,int)")
+    main_lines = _main_file(params)
+    add_file("main.c", main_lines, [main_lines.index("int main(void) {")], "int()")
+
+    defined = {function["name"] for function in functions}
+    stubs = sorted({call["name"] for call in call_records} - defined)
+    functions += [
+        {"name": name, "file": "<unknown>", "lineNumber": -1, "code": "<empty>", "signature": ""} for name in stubs
+    ]
+    return functions, call_records
+
+
+@click.command()
+@click.option("--files", type=click.IntRange(min=1), default=10, show_default=True, help="Number of source files")
+@click.option(
+    "--functions-per-file",
+    type=click.IntRange(min=1),
+    default=10,
+    show_default=True,
+    help="Number of functions per source file",
+)
+@click.option("--fan-out", default=3, show_default=True, help="Number of forward calls per function")
+@click.option("--recursion-density", default=0.05, show_default=True, help="Fraction of recursive functions")
+@click.option("--header-depth", default=2, show_default=True, help="Length of the shared include chain")
+@click.option("--body-size", default=5, show_default=True, help="Number of statements per function")
+@click.option("--sink-ratio", default=0.05, show_default=True, help="Fraction of functions calling a system function")
+@click.option("--seed", default=0, show_default=True, help="Random seed")
+@click.option(
+    "--output",
+    type=click.Path(file_okay=False, dir_okay=True, path_type=Path),
+    default=None,
+    help="Output directory [default: test_code/generated/<files>x<functions-per-file>_s<seed>]",
+)
+def main(
+    files: int,
+    functions_per_file: int,
+    fan_out: int,
+    recursion_density: float,
+    header_depth: int,
+    body_size: int,
+    sink_ratio: float,
+    seed: int,
+    output: Path,
+) -> None:
+    """
+    Generate a deterministic synthetic C codebase for scalability benchmarking.
+    """
+    params = GeneratorParameters(
+        files, functions_per_file, fan_out, recursion_density, header_depth, body_size, sink_ratio, seed
+    )
+    if output is None:
+        output = Path(__file__).parent / "test_code" / "generated" / f"{files}x{functions_per_file}_s{seed}"
+
+    manifest = generate_codebase(output, params)
+    logger.info(f"Generated {manifest['functions']} functions with {manifest['calls']} calls in {output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -10,9 +10,29 @@ function information and call graphs from the analyzed code.
 The analyzer runs Joern in a Docker container to ensure consistent analysis environment
 and handles the complete analysis workflow including:
 - Starting/stopping the Joern server
-- Importing source code
+- Importing source code, limited to the translation units of a compile_commands.json
 - Running analysis scripts
 - Processing and storing results
+- Timing every phase of the run and saving the timings as timings.json
+- Optionally profiling the Joern JVMs with Java Flight Recorder
+- Sampling the CPU, memory and block I/O usage of the container from its cgroup
+- Reporting the parse cost of every source file as parse_report.json
+- Optionally indexing only the function signatures and call edges, without bodies
+- Skipping files c2cpg fails or hangs on, and returning partial results when the
+  job deadline passes
+- Limiting the container to the CPUs and memory estimated for the job, and waiting
+  until the host has them free (see utils/job_scheduler.py)
+- Keeping the CPGs and the Joern workspace on a tmpfs in the container, so that
+  only the extracted results are written to the results directory
+- Running the setup, c2cpg and the analysis script in a single docker exec
+  (see joern_scripts/pipeline.sh)
+- Starting the container while uploaded code is still being extracted
+- Analyzing many code directories in batch mode, with a pool of containers that
+  are kept running between the jobs
+
+With the offline backend, the container is emulated on the host and the Joern output
+is replayed or synthesized (see utils/offline_docker_manager.py), so the rest of the
+pipeline can be run and benchmarked without Docker.
 
 Dependencies:
     - Docker (for running Joern)
@@ -21,18 +41,50 @@ Dependencies:
 """
 
 import hashlib
+import os
+import queue
 import sys
-from pathlib import Path
-from typing import Optional, List, Dict, Any, cast
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path, PurePosixPath
+from typing import Optional, List, Dict, Any, Tuple, cast
 import json
+import shlex
+import shutil
 
 import click
 from loguru import logger
 
 from results_processor import ResultsProcessor
-from settings import ANALYSIS_SETTINGS, C_CPP_EXTENSIONS, CONTAINER_PATHS, DOCKER_SETTINGS, JAVA_OPTS
+from settings import ANALYSIS_MODES, ANALYSIS_SETTINGS, C_CPP_EXTENSIONS, CONTAINER_PATHS, DOCKER_SETTINGS, JAVA_OPTS
+from utils.compilation_database import prepare_compilation_database
 from utils.docker_manager import DockerManager
 from utils.file_handler import FileHandler
+from utils.jfr_summary import JFR_PRINT_EVENTS, summarize_recording
+from utils.job_scheduler import SCHEDULER, Allocation, estimate_job_resources, estimate_scratch_mb
+from utils.metrics import RunTimings
+from utils.offline_docker_manager import OfflineDockerManager
+from utils.parse_report import build_parse_report, parse_frontend_report
+from utils.resource_sampler import ResourceSampler
+from utils.tracing import TRACER
+from utils.zip_extraction import ZipExtraction
+
+# Phase of each stage of joern_scripts/pipeline.sh
+PIPELINE_PHASES = {"setup": "directory_setup", "c2cpg": "c2cpg_import", "analysis": "script_run"}
+
+# Exit code of a stage killed by timeout -s KILL
+KILLED_EXIT_CODE = 128 + 9
+
+# Message of ENOSPC, e.g. in "java.io.IOException: No space left on device"
+NO_SPACE_MESSAGE = "No space left on device"
+
+# Fewest levels below / of the common root of a batch, which is mounted into the
+# containers: a top-level directory like /home would expose far more than the code
+MIN_BATCH_ROOT_DEPTH = 2
+
+
+class ScratchSpaceError(RuntimeError):
+    """The scratch space of the container ran full."""
 
 
 class JoernAnalyzer:
@@ -52,27 +104,85 @@ class JoernAnalyzer:
         results_processor (Optional[ResultsProcessor]): Processor for analysis results
         functions_info (List[Dict[str, Any]]): List of function information dictionaries
         call_graph (List[Dict[str, Any]]): List of call graph entries
+        timings (RunTimings): Phase timings, output sizes and counts of the last run
+        profile (bool): Whether c2cpg and the analysis script are recorded with JFR
+        mode (str): Analysis mode, "full" or "signatures"
+        resource_sampler (Optional[ResourceSampler]): Sampler of the container's
+            cgroup counters during the running job
+        frontend_report (Dict[str, Dict[str, Any]]): Per-file report logged by the c2cpg
+            runs of the last analysis, if the parse cost is reported (see parse_report)
+        translation_units (List[str]): Files of the compilation database of the
+            analyzed code, relative to its root; empty without one
+        database_entries (List[Dict[str, Any]]): Entries of that compilation database,
+            mapped into the container
+        skipped_files (List[Dict[str, str]]): Files that were not parsed, with the
+            reason ("timeout", "error" or "deadline")
+        deadline (float): time.monotonic() by which the running analysis must finish
+        allocation (Optional[Allocation]): CPUs and memory reserved for the running job
+        scratch_mb (int): Size of the scratch space of the running job (MiB), 0 if disabled
+        cpg_files (List[str]): Container paths of the CPGs c2cpg generated for the running job
+        code_root (Optional[Path]): Common root of the analyzed code in batch mode, where
+            the container is kept running between jobs; None to start a container per job
+        results_root (Path): Directory of the results directories in batch mode
     """
 
-    def __init__(self) -> None:
+    # Names of the profiled JVM runs, used for the recording file names
+    PROFILED_RUNS = ["c2cpg", "joern"]
+
+    def __init__(
+        self,
+        profile: Optional[bool] = None,
+        backend: Optional[str] = None,
+        mode: Optional[str] = None,
+        code_root: Optional[Path] = None,
+    ) -> None:
         """
         Initialize the Joern analyzer.
 
         Sets up the Docker manager with Joern image and initializes file handling
         components. The analyzer is ready to perform code analysis after initialization.
+
+        Args:
+            profile (Optional[bool]): Record c2cpg and the analysis script with Java
+                Flight Recorder; defaults to the profiling setting in ANALYSIS_SETTINGS
+            backend (Optional[str]): "docker" or "offline"; defaults to the backend in
+                DOCKER_SETTINGS
+            mode (Optional[str]): "full", or "signatures" for a lightweight index of the
+                functions and calls without function bodies; defaults to the mode in
+                ANALYSIS_SETTINGS
+            code_root (Optional[Path]): Keep the container running between jobs, with
+                this directory and the results root mounted; every analyzed path must
+                be inside it. Call close() to stop the container.
         """
         self.code_path: Optional[Path] = None
         self.results_path: Optional[Path] = None
-        docker_settings = cast(Dict[str, Dict[str, str]], DOCKER_SETTINGS)
-        self.docker_manager = DockerManager(
-            image=docker_settings["joern"]["image"], platform=docker_settings["joern"]["platform"]
-        )
+        joern_settings = DOCKER_SETTINGS["joern"]
+        backend = DOCKER_SETTINGS["backend"] if backend is None else backend
+        manager_class = OfflineDockerManager if backend == "offline" else DockerManager
+        self.docker_manager = manager_class(image=joern_settings["image"], platform=joern_settings["platform"])
         self.file_handler = FileHandler()
         self.results_processor: Optional[ResultsProcessor] = None
         self.functions_info: List[Dict[str, Any]] = []
         self.call_graph: List[Dict[str, Any]] = []
-
-    def analyze(self, path: Path, base_path: Optional[Path] = None) -> None:
+        self.timings = RunTimings()
+        self.profile = ANALYSIS_SETTINGS["profiling"]["enabled"] if profile is None else profile
+        self.mode = ANALYSIS_SETTINGS["mode"] if mode is None else mode
+        if self.mode not in ANALYSIS_MODES:
+            raise ValueError(f"Unknown analysis mode: {self.mode}")
+        self.resource_sampler: Optional[ResourceSampler] = None
+        self.frontend_report: Dict[str, Dict[str, Any]] = {}
+        self.translation_units: List[str] = []
+        self.database_entries: List[Dict[str, Any]] = []
+        self.skipped_files: List[Dict[str, str]] = []
+        self.deadline = 0.0
+        self.allocation: Optional[Allocation] = None
+        self.scratch_mb = 0
+        self._container_scratch_mb = 0
+        self.cpg_files: List[str] = []
+        self.code_root = code_root.resolve() if code_root else None
+        self.results_root = Path.cwd() / "results"
+
+    def analyze(self, path: Path, base_path: Optional[Path] = None, extraction: Optional[ZipExtraction] = None) -> None:
         """
         Analyze C/C++ code at the given path.
 
@@ -83,44 +193,127 @@ class JoernAnalyzer:
         4. Runs the analysis
         5. Processes and stores the results
 
+        Steps 2 to 4 run as the stages of a single docker exec (see _run_pipeline()).
+
+        The duration of every phase is saved to timings.json in the results directory,
+        also when the analysis fails. The run and its phases are traced as spans,
+        including the spans recorded by analysis.sc inside the container.
+
+        When profiling, the JFR recordings are written to the profiles/ subdirectory of
+        the results directory and summarized in profile_summary.json, also when the
+        analysis fails (e.g. when the JVM runs out of memory).
+
+        The run must finish within the job timeout. Files c2cpg fails or hangs on, and
+        the files not parsed by the deadline, are skipped and recorded in
+        skipped_files.json; the results of the other files are processed as usual and
+        the run finishes with the status "partial".
+
+        If the code is still being extracted, the analysis waits for free resources and
+        starts the container in the meantime, and waits for the extraction before the
+        code is imported. The container mounts the directory the code is extracted into.
+
+        With a code root, the container of the previous job is reused and stopped only
+        if the job fails. Its scratch space is emptied before the resources of the job
+        are released, since the tmpfs holds memory the next job is counted with.
+
         Args:
             path (Path): Path to the C/C++ source code to analyze
             base_path (Optional[Path]): Optional base path for relative path calculations.
                 If not provided, a results directory will be created based on the code path hash.
+            extraction (Optional[ZipExtraction]): Running extraction of the code to path
 
         Raises:
             RuntimeError: If any step in the analysis workflow fails
         """
-        try:
-            if base_path is None:
-                code_path_abs = Path(path).resolve()
-                code_path_abs_hash = hashlib.sha512(str(code_path_abs).encode()).hexdigest()
-                base_path = Path.cwd() / "results" / code_path_abs_hash
-                base_path.mkdir(parents=True, exist_ok=True)
-
-            logger.info(f"Analyzing C/C++ code at: {path}")
-            logger.info(f"Storing results at: {base_path}")
-
-            self.code_path = path
-            self.results_path = base_path
-            self.results_processor = ResultsProcessor(self.results_path)
-
-            if not self._start_server():
-                raise RuntimeError("Failed to start Joern server")
-
-            if not self._setup_results_directory():
-                raise RuntimeError("Failed to setup results directory")
-
-            if not self._import_code():
-                raise RuntimeError("Failed to import code and generate CPG")
-
-            if not self._run_analysis():
-                raise RuntimeError("Failed to run analysis")
-
-            self._process_results()
-
-        finally:
-            self._stop_server()
+        self.timings = RunTimings(mode=self.mode)
+        self.functions_info = []
+        self.call_graph = []
+        self.frontend_report = {}
+        self.skipped_files = []
+        self.cpg_files = []
+        success = False
+        with TRACER.span("joern_analyzer.analyze", attributes={"code.path": str(path)}):
+            try:
+                if base_path is None:
+                    code_path_abs = Path(path).resolve()
+                    code_path_abs_hash = hashlib.sha512(str(code_path_abs).encode()).hexdigest()
+                    base_path = Path.cwd() / "results" / code_path_abs_hash
+                    base_path.mkdir(parents=True, exist_ok=True)
+
+                logger.info(f"Analyzing C/C++ code at: {path}")
+                logger.info(f"Storing results at: {base_path}")
+
+                # The code path is only linked to the extracted directory when the
+                # extraction is complete, and the container mounts it before that
+                self.code_path = extraction.directory if extraction else path
+                self.results_path = base_path
+                self.results_processor = ResultsProcessor(self.results_path, timings=self.timings)
+
+                with self.timings.phase("queue_wait"):
+                    self._reserve_resources(extraction.source_bytes if extraction else None)
+                self.deadline = time.monotonic() + ANALYSIS_SETTINGS["timeout"]["job"]
+
+                with self.timings.phase("container_start"):
+                    if not self._start_server():
+                        raise RuntimeError("Failed to start Joern server")
+                self._start_resource_sampler()
+
+                if extraction:
+                    with self.timings.phase("extraction_wait"):
+                        extraction.wait()
+
+                with self.timings.phase("import_prepare"):
+                    prepared = self._prepare_import()
+                    if prepared is None:
+                        raise RuntimeError("Failed to import code and generate CPG")
+                files, database_args = prepared
+
+                exit_codes = self._run_pipeline(database_args)
+                TRACER.import_spans(base_path / "spans.json")
+                if exit_codes.get("setup") != 0:
+                    raise RuntimeError("Failed to setup results directory")
+
+                if exit_codes.get("c2cpg") != 0:
+                    # Parse the files again in separate runs to skip the offending ones
+                    with self.timings.phase("c2cpg_import"):
+                        if not self._isolate_files(files, exit_codes.get("c2cpg") == KILLED_EXIT_CODE):
+                            raise RuntimeError("Failed to import code and generate CPG")
+
+                    with self.timings.phase("script_run"):
+                        analysis_success = self._run_analysis()
+                        TRACER.import_spans(base_path / "spans.json")
+                        if not analysis_success:
+                            raise RuntimeError("Failed to run analysis")
+                elif exit_codes.get("analysis") != 0:
+                    raise RuntimeError("Failed to run analysis")
+
+                if self.parse_report:
+                    with self.timings.phase("parse_report"):
+                        self._write_parse_report()
+
+                self._process_results()
+                success = True
+
+            finally:
+                if self.resource_sampler:
+                    self._stop_resource_sampler()
+                if self.profile and self.docker_manager.container_id:
+                    with self.timings.phase("profile_summary"):
+                        self._summarize_profiles()
+                # A container whose scratch space cannot be emptied is not reused
+                keep_container = self.code_root is not None and success
+                if keep_container:
+                    with self.timings.phase("scratch_cleanup"):
+                        keep_container = self._clear_scratch()
+                if not keep_container:
+                    with self.timings.phase("container_stop"):
+                        self._stop_server()
+                if self.allocation:
+                    SCHEDULER.release(self.allocation)
+                    self.allocation = None
+                self.timings.finish(success, complete=not self.skipped_files)
+                if self.results_path:
+                    self.timings.save(self.results_path / "timings.json")
 
     def _start_server(self) -> bool:
         """
@@ -132,6 +325,9 @@ class JoernAnalyzer:
         Returns:
             bool: True if server started successfully, False otherwise
         """
+        if self.code_root is not None:
+            return self._start_warm_server()
+
         logger.info("Starting Joern server...")
 
         joern_scripts_path = Path(__file__).parent / "joern_scripts"
@@ -149,8 +345,10 @@ class JoernAnalyzer:
             image=self.docker_manager.image,
             command=["tail", "-f", "/dev/null"],
             volumes=volumes,
-            environment={"JAVA_OPTS": " ".join(JAVA_OPTS), "JOERN_LOG_LEVEL": "debug"},
+            environment={"JAVA_OPTS": " ".join(self._java_opts()), "JOERN_LOG_LEVEL": "debug"},
             working_dir=container_paths["results"],
+            allocation=self.allocation,
+            tmpfs=self._scratch_mounts(),
         )
 
         if not success:
@@ -159,29 +357,256 @@ class JoernAnalyzer:
 
         return True
 
-    def _setup_results_directory(self) -> bool:
+    def _start_warm_server(self) -> bool:
+        """
+        Start the Joern server of batch mode, or reuse the running one.
+
+        The code root and the results root are mounted; each job reads and writes its
+        own directories in them (see container_code_path and container_results_path).
+        The limits of a reused container are updated to the allocation of the job.
+
+        Returns:
+            bool: True if the server is running with the limits of the job, False otherwise
         """
-        Set up the results directory in the container.
+        if self.results_path:
+            # The job's results directory is inside the mounted results root, so Docker does not create it
+            Path(self.results_path).mkdir(parents=True, exist_ok=True)
+        if self.docker_manager.container_id and self._container_scratch_mb < self.scratch_mb:
+            # The size of a tmpfs is fixed when the container starts
+            logger.info("Restarting the Joern server with a larger scratch space...")
+            self._stop_server()
+        if self.docker_manager.container_id:
+            logger.info("Reusing the running Joern server...")
+            return self.allocation is None or self.docker_manager.update_limits(self.allocation)
+
+        logger.info("Starting Joern server for batch mode...")
+        container_paths = cast(Dict[str, str], CONTAINER_PATHS)
+        self.results_root.mkdir(parents=True, exist_ok=True)
+        volumes = {
+            str(self.code_root): {"bind": container_paths["batch_code"], "mode": "ro"},
+            str(self.results_root): {"bind": container_paths["batch_results"], "mode": "rw"},
+            str(Path(__file__).parent / "joern_scripts"): {"bind": container_paths["scripts"], "mode": "ro"},
+        }
+        if not self.docker_manager.start_container(
+            image=self.docker_manager.image,
+            command=["tail", "-f", "/dev/null"],
+            volumes=volumes,
+            environment={"JAVA_OPTS": " ".join(self._java_opts()), "JOERN_LOG_LEVEL": "debug"},
+            working_dir=container_paths["batch_results"],
+            allocation=self.allocation,
+            tmpfs=self._scratch_mounts(),
+        ):
+            logger.error("Failed to start Joern server")
+            return False
+        return True
+
+    def _batch_paths(self) -> Tuple[str, str]:
+        """
+        Get the container paths of the code and results directories of the job in batch mode.
+
+        Returns:
+            Tuple[str, str]: The code directory and the results directory
+
+        Raises:
+            ValueError: If the code is not inside the code root, or the results
+                directory not inside the results root
+        """
+        if self.code_root is None or self.code_path is None or self.results_path is None:
+            raise ValueError("Not a batch mode job")
+        code = Path(self.code_path).resolve().relative_to(self.code_root)
+        results = Path(self.results_path).resolve().relative_to(self.results_root.resolve())
+        return (
+            str(PurePosixPath(CONTAINER_PATHS["batch_code"], *code.parts)),
+            str(PurePosixPath(CONTAINER_PATHS["batch_results"], *results.parts)),
+        )
+
+    def close(self) -> None:
+        """Stop the container kept running in batch mode."""
+        if self.docker_manager.container_id:
+            self._stop_server()
+
+    def _clear_scratch(self) -> bool:
+        """
+        Empty the scratch space of the container kept running in batch mode.
+
+        Returns:
+            bool: True if the scratch space is empty or there is none, False otherwise
+        """
+        if not self._container_scratch_mb or not self.docker_manager.container_id:
+            return True
+        success, _, stderr = self.docker_manager.execute_command(
+            ["find", CONTAINER_PATHS["scratch"], "-mindepth", "1", "-delete"]
+        )
+        if not success:
+            logger.error(f"Failed to empty the scratch space: {stderr}")
+        return success
+
+    def _scratch_mounts(self) -> Dict[str, str]:
+        """
+        Get the tmpfs mounts of the container.
+
+        Returns:
+            Dict[str, str]: The mount options of the scratch space, if enabled
+        """
+        self._container_scratch_mb = self.scratch_mb
+        if not self.scratch_mb:
+            return {}
+        return {CONTAINER_PATHS["scratch"]: f"rw,size={self.scratch_mb}m,mode=1777"}
+
+    @property
+    def parse_report(self) -> bool:
+        """Whether the parse cost of every file is reported; never for the lightweight signatures index."""
+        return ANALYSIS_SETTINGS["parse_report"] and self.mode != "signatures"
+
+    @property
+    def container_code_path(self) -> str:
+        """Container directory of the analyzed code; in batch mode, its directory under the code root."""
+        return self._batch_paths()[0] if self.code_root is not None else CONTAINER_PATHS["app"]
+
+    @property
+    def container_results_path(self) -> str:
+        """Container directory of the results; in batch mode, its directory under the results root."""
+        return self._batch_paths()[1] if self.code_root is not None else CONTAINER_PATHS["results"]
+
+    @property
+    def cpg_path(self) -> str:
+        """Container directory of the CPGs and the Joern workspace."""
+        return CONTAINER_PATHS["scratch"] if self.scratch_mb else self.container_results_path
+
+    def _reserve_resources(self, source_bytes: Optional[int] = None) -> None:
+        """
+        Reserve the CPUs and memory of the job, waiting until the host has them free.
+
+        The resources and the size of the scratch space are estimated from the size of
+        the source files and limit the container. The scratch space is backed by the
+        memory of the container, so its size is added to the memory. Nothing is
+        reserved if the limits are disabled.
+
+        Args:
+            source_bytes (Optional[int]): Size of the source files, if known before they
+                are extracted; otherwise the files are measured
+        """
+        limits = DOCKER_SETTINGS["limits"]
+        scratch = DOCKER_SETTINGS["scratch"]
+        self.scratch_mb = 0
+        if not (limits["enabled"] or scratch["enabled"]) or self.code_path is None:
+            return
+
+        if source_bytes is None:
+            source_bytes = sum(
+                file.stat().st_size for file in self.file_handler.find_source_files(self.code_path, C_CPP_EXTENSIONS)
+            )
+        self.scratch_mb = estimate_scratch_mb(source_bytes, scratch)
+        if self.scratch_mb:
+            self.timings.record_resources({"limit_scratch_bytes": self.scratch_mb * 1024 * 1024})
+        if not limits["enabled"]:
+            return
+
+        resources = estimate_job_resources(source_bytes, limits)
+        resources = SCHEDULER.fit(resources._replace(memory_mb=resources.memory_mb + self.scratch_mb))
+        logger.info(
+            f"Waiting for {resources.cpus} CPUs and {resources.memory_mb} MiB for {source_bytes} bytes of source"
+        )
+        self.allocation = SCHEDULER.acquire(resources)
+        logger.info(f"Running on NUMA node {self.allocation.node}, CPUs {self.allocation.cpus}")
+        self.timings.record_resources(
+            {"limit_cpus": len(self.allocation.cpus), "limit_memory_bytes": self.allocation.memory_mb * 1024 * 1024}
+        )
+
+    def _java_opts(self) -> List[str]:
+        """
+        Get the JVM options, with the heap sized to the memory limit of the job.
+
+        Returns:
+            List[str]: JAVA_OPTS, with -Xmx set to the heap fraction of the memory limit
+                without the scratch space
+        """
+        if not self.allocation:
+            return JAVA_OPTS
+        memory_mb = max(self.allocation.memory_mb - self.scratch_mb, DOCKER_SETTINGS["limits"]["min_memory_mb"])
+        heap_mb = int(memory_mb * DOCKER_SETTINGS["limits"]["heap_fraction"])
+        return [opt for opt in JAVA_OPTS if not opt.startswith("-Xmx")] + [f"-Xmx{heap_mb}m"]
+
+    def _setup_commands(self) -> List[List[str]]:
+        """
+        Get the commands setting up the results directory in the container.
 
         Creates and configures the results directory with appropriate permissions
         for storing analysis outputs.
 
         Returns:
-            bool: True if directory setup was successful, False otherwise
+            List[List[str]]: The commands
         """
-        container_paths = cast(Dict[str, str], CONTAINER_PATHS)
-        results_path = container_paths["results"]
+        results_path = self.container_results_path
+        commands = [["mkdir", "-p", results_path], ["chmod", "777", results_path]]
+        if self.profile:
+            commands.append(["mkdir", "-p", f"{results_path}/profiles"])
+        return commands
 
-        # Create commands with proper typing
-        commands: List[List[str]] = [["mkdir", "-p", results_path], ["chmod", "777", results_path]]
+    def _run_pipeline(self, database_args: List[str]) -> Dict[str, int]:
+        """
+        Run the setup, c2cpg and analysis stages in a single docker exec.
 
-        for cmd in commands:
-            success, stdout, stderr = self.docker_manager.execute_command(cmd)
-            if not success:
-                logger.error(f"Failed to setup results directory: {stderr}")
-                return False
+        The stages run in joern_scripts/pipeline.sh, which stops at the first failing
+        stage and appends a completion event with the exit code and duration of each
+        stage to pipeline_events.jsonl. The durations are recorded as the phases of
+        the stages.
 
-        return True
+        Args:
+            database_args (List[str]): Compilation database arguments of c2cpg
+
+        Returns:
+            Dict[str, int]: The exit code of each stage that ran
+
+        Raises:
+            RuntimeError: If no stage finished, with the error output of docker exec
+        """
+        if self.results_path is None:
+            return {}
+
+        container_paths = cast(Dict[str, str], CONTAINER_PATHS)
+        timeouts = ANALYSIS_SETTINGS["timeout"]
+        cpg_file = f"{self.cpg_path}/cpg.bin"
+        c2cpg_timeout = max(1, self._remaining(timeouts["command_execution"], timeouts["analysis_reserve"]))
+        stages = {
+            "setup": " && ".join(shlex.join(command) for command in self._setup_commands()),
+            "c2cpg": shlex.join(self._c2cpg_command(database_args, cpg_file, c2cpg_timeout)),
+            "analysis": self._analysis_command([cpg_file], timeouts["command_execution"]),
+        }
+        command = [
+            "sh",
+            f"{container_paths['scripts']}/pipeline.sh",
+            f"{self.container_results_path}/pipeline_events.jsonl",
+            *(f"{name}={stage}" for name, stage in stages.items()),
+        ]
+
+        # The stages are killed inside the container on timeout; the margin covers docker exec itself
+        success, stdout, stderr = self.docker_manager.execute_command(
+            command, timeout=self._remaining(timeouts["job"]) + 30
+        )
+        self._collect_frontend_report(stdout + stderr)
+
+        events_file = self.results_path / "pipeline_events.jsonl"
+        exit_codes: Dict[str, int] = {}
+        if events_file.exists():
+            for line in events_file.read_text().splitlines():
+                event = json.loads(line)
+                exit_codes[event["stage"]] = event["exit_code"]
+                self.timings.record_phase(PIPELINE_PHASES[event["stage"]], event["milliseconds"] / 1000)
+            events_file.unlink()
+        if not exit_codes:
+            # Not even the setup stage finished, so docker exec itself failed or timed out
+            raise RuntimeError(f"Failed to run the pipeline: {stderr.strip() or 'docker exec failed without output'}")
+
+        if exit_codes.get("c2cpg") == 0:
+            self.cpg_files.append(cpg_file)
+        elif "c2cpg" in exit_codes:
+            self._remove_cpg(cpg_file)
+        if not success:
+            failed = next((name for name, code in exit_codes.items() if code != 0), "pipeline")
+            logger.error(f"Pipeline stage {failed} failed: {stderr}")
+            self._check_scratch_space(stdout + stderr)
+        return exit_codes
 
     def _stop_server(self) -> None:
         """
@@ -192,87 +617,484 @@ class JoernAnalyzer:
         logger.info("Stopping Joern server...")
         self.docker_manager.stop_container()
 
-    def _import_code(self) -> bool:
+    def _prepare_import(self) -> Optional[Tuple[List[str], List[str]]]:
         """
-        Import code into Joern and generate Code Property Graph (CPG).
+        Prepare the import of the code into Joern.
 
-        Scans the source directory for C/C++ files and uses Joern's c2cpg tool
-        to generate the initial CPG representation of the code.
+        Scans the source directory for C/C++ files. If the code comes with a
+        compilation database, only its translation units are parsed.
 
         Returns:
-            bool: True if code import was successful, False otherwise
+            Optional[Tuple[List[str], List[str]]]: The files to parse relative to the code
+                root and the compilation database arguments of c2cpg, or None if there
+                is no code to import
         """
         logger.info("Importing code into Joern...")
 
-        if self.code_path is None:
+        if self.code_path is None or self.results_path is None:
             logger.error("Code path is not set")
-            return False
+            return None
 
         source_files = self.file_handler.find_source_files(self.code_path, C_CPP_EXTENSIONS)
         if not source_files:
             logger.error(f"No C/C++ source files found in {self.code_path}")
-            return False
+            return None
 
         logger.info(f"Found {len(source_files)} C/C++ source files")
+        self.timings.record_count("source_files", len(source_files))
 
-        container_paths = cast(Dict[str, str], CONTAINER_PATHS)
-        app_path = container_paths["app"]
-        results_path = container_paths["results"]
+        (self.results_path / "skipped_files.json").unlink(missing_ok=True)
+
+        database_args = self._compilation_database_args()
+        files = self.translation_units or sorted(file.relative_to(self.code_path).as_posix() for file in source_files)
+        return files, database_args
+
+    def _isolate_files(self, files: List[str], timed_out: bool) -> bool:
+        """
+        Import the code in chunks after c2cpg failed or timed out on the whole code.
+
+        The files are parsed again in chunks, each into its own CPG, to isolate the
+        offending files (see _import_in_chunks()). The skipped files are saved to
+        skipped_files.json.
+
+        Args:
+            files (List[str]): Files to parse, relative to the code root
+            timed_out (bool): Whether c2cpg timed out on the whole code
+
+        Returns:
+            bool: True if at least one CPG was generated, False otherwise
+        """
+        logger.warning(f"c2cpg {'timed out' if timed_out else 'failed'}, isolating the offending files")
+        self._import_in_chunks(files)
+
+        if self.skipped_files and self.results_path:
+            logger.warning(f"Skipped {len(self.skipped_files)} files, the results are incomplete")
+            self.file_handler.write_json(self.skipped_files, self.results_path / "skipped_files.json")
+            self.timings.record_count("skipped_files", len(self.skipped_files))
+
+        return bool(self.cpg_files)
+
+    def _remaining(self, limit: int, reserve: int = 0) -> int:
+        """
+        Get the timeout of a command, limited by the job deadline.
+
+        Args:
+            limit (int): Timeout of the command in seconds
+            reserve (int): Seconds before the deadline to keep free for later steps
+
+        Returns:
+            int: The timeout in seconds, 0 if the deadline has passed
+        """
+        return max(0, min(limit, int(self.deadline - reserve - time.monotonic())))
+
+    def _c2cpg_command(self, database_args: List[str], cpg_file: str, timeout: int) -> List[str]:
+        """
+        Get the c2cpg command for the analyzed code.
+
+        c2cpg is killed inside the container when it times out, so that no JVM keeps
+        running after the timeout.
 
-        # Create command with proper typing
-        command: List[str] = [
+        Args:
+            database_args (List[str]): Compilation database arguments
+            cpg_file (str): Container path of the CPG
+            timeout (int): Timeout in seconds
+
+        Returns:
+            List[str]: The command
+        """
+        app_path = self.container_code_path
+
+        # The frontend logs its per-file report at debug level
+        log_level = ["env", "SL_LOGGING_LEVEL=debug"] if self.parse_report else []
+
+        return [
+            *log_level,
+            "timeout",
+            "-s",
+            "KILL",
+            str(timeout),
             "/opt/joern/joern-cli/c2cpg.sh",
-            *[f"-J{opt}" for opt in JAVA_OPTS],
+            *[f"-J{opt}" for opt in self._java_opts() + self._profiling_opts("c2cpg")],
             app_path,
+            *database_args,
+            # Image locations (how a name got into a translation unit) are not needed for an index
+            *(["--no-image-locations"] if self.mode == "signatures" else []),
             "--output",
-            f"{results_path}/cpg.bin",
+            cpg_file,
         ]
 
-        success, stdout, stderr = self.docker_manager.execute_command(
-            command,
-            timeout=ANALYSIS_SETTINGS["timeout"]["command_execution"],
-        )
+    def _run_c2cpg(self, database_args: List[str], output: str, timeout: int) -> Tuple[bool, bool]:
+        """
+        Run c2cpg on the analyzed code in its own docker exec.
+
+        Args:
+            database_args (List[str]): Compilation database arguments
+            output (str): Name of the CPG file in the scratch space
+            timeout (int): Timeout in seconds
+
+        Returns:
+            Tuple[bool, bool]: Whether the run succeeded and whether it timed out
+        """
+        if timeout <= 0:
+            return False, True
+
+        cpg_file = f"{self.cpg_path}/{output}"
+        command = self._c2cpg_command(database_args, cpg_file, timeout)
+
+        start = time.monotonic()
+        # The container kills c2cpg first; the margin covers docker exec itself
+        success, stdout, stderr = self.docker_manager.execute_command(command, timeout=timeout + 30)
+        self._collect_frontend_report(stdout + stderr)
 
         if not success:
             logger.error(f"Failed to import code: {stderr}")
-            return False
+            self._remove_cpg(cpg_file)
+            self._check_scratch_space(stdout + stderr)
+            return False, time.monotonic() - start >= timeout
 
-        return True
+        self.cpg_files.append(cpg_file)
+        return True, False
+
+    def _remove_cpg(self, cpg_file: str) -> None:
+        """
+        Remove the output of a failed c2cpg run, so that it does not fill the scratch space.
+
+        Args:
+            cpg_file (str): Container path of the CPG
+        """
+        self.docker_manager.execute_command(["rm", "-f", cpg_file])
+
+    def _check_scratch_space(self, output: str) -> None:
+        """
+        Check the output of a failed command for a full scratch space.
+
+        A full scratch space is not caused by the parsed files, so it fails the job
+        instead of starting the isolation of the files.
+
+        Args:
+            output (str): Standard output and error of the command
+
+        Raises:
+            ScratchSpaceError: If the command ran out of space
+        """
+        if NO_SPACE_MESSAGE in output:
+            raise ScratchSpaceError(
+                f"The scratch space of {self.scratch_mb} MiB is full; increase size_per_source_mb or max_size_mb "
+                "of scratch in DOCKER_SETTINGS"
+            )
+
+    def _import_in_chunks(self, files: List[str]) -> None:
+        """
+        Parse the files in chunks to isolate the files c2cpg fails or hangs on.
+
+        Each chunk is parsed into its own CPG (cpg_<n>.bin), with a timeout of the
+        startup time plus the parse time per file, but at most the isolation chunk
+        budget of the time left, so that a chunk hanging on a file leaves the time to
+        split it down to that file. c2cpg is given a compilation
+        database of the files of the chunk (see _chunk_database_args()), so that the
+        command line does not grow with the code. A failing chunk is split in halves
+        until the offending single files remain, which are skipped. The analysis
+        reserve of the job timeout is kept free for the analysis script and the
+        results processing; files not parsed before it are skipped too.
+
+        Args:
+            files (List[str]): Files to parse, relative to the code root
+        """
+        timeouts = ANALYSIS_SETTINGS["timeout"]
+        size = ANALYSIS_SETTINGS["isolation_chunk_files"]
+        single_file_timeout = timeouts["parse_startup"] + timeouts["parse_file"]
+        pending = [files[start : start + size] for start in range(0, len(files), size)]
+        runs = 0
+        try:
+            while pending:
+                chunk = pending.pop(0)
+                left = self._remaining(timeouts["job"], timeouts["analysis_reserve"])
+                budget = max(single_file_timeout, int(left * ANALYSIS_SETTINGS["isolation_chunk_budget"]))
+                timeout = self._remaining(
+                    min(timeouts["parse_startup"] + timeouts["parse_file"] * len(chunk), budget),
+                    timeouts["analysis_reserve"],
+                )
+                if timeout <= 0:
+                    unparsed = chunk + [file for rest in pending for file in rest]
+                    logger.warning(f"Job deadline near with {len(unparsed)} files not parsed")
+                    self.skipped_files += [{"file": file, "reason": "deadline"} for file in unparsed]
+                    break
+
+                runs += 1
+                chunk_args = self._chunk_database_args(chunk, runs)
+                success, timed_out = self._run_c2cpg(chunk_args, f"cpg_{len(self.cpg_files)}.bin", timeout)
+                if success:
+                    continue
+                if len(chunk) > 1:
+                    pending[:0] = [chunk[: len(chunk) // 2], chunk[len(chunk) // 2 :]]
+                else:
+                    reason = "timeout" if timed_out else "error"
+                    logger.warning(f"Skipping {chunk[0]}: c2cpg {'timed out' if timed_out else 'failed'}")
+                    self.skipped_files.append({"file": chunk[0], "reason": reason})
+        finally:
+            if self.results_path:
+                shutil.rmtree(self.results_path / "chunks", ignore_errors=True)
+
+    def _chunk_database_args(self, chunk: List[str], run: int) -> List[str]:
+        """
+        Get the c2cpg arguments for a compilation database of a chunk of files.
+
+        The database lists the entries of the files in the compilation database of the
+        code, or, without one, the files without flags, so that c2cpg parses only the
+        files of the chunk. It is written to the chunks/ subdirectory of the results
+        directory, which is removed after the isolation.
+
+        Args:
+            chunk (List[str]): Files of the chunk, relative to the code root
+            run (int): Number of the c2cpg run, for the file name
+
+        Returns:
+            List[str]: The arguments
+        """
+        if self.results_path is None:
+            return []
+        app_path = self.container_code_path
+        included = {f"{app_path}/{file}" for file in chunk}
+        entries = [entry for entry in self.database_entries if entry["file"] in included] or [
+            {"directory": app_path, "file": file, "arguments": ["cc", "-c", file]} for file in sorted(included)
+        ]
+        name = f"chunks/compile_commands_{run}.json"
+        (self.results_path / "chunks").mkdir(exist_ok=True)
+        self.file_handler.write_json(entries, self.results_path / name)
+        return ["--compilation-database", f"{self.container_results_path}/{name}"]
+
+    def _compilation_database_args(self) -> List[str]:
+        """
+        Get the c2cpg arguments for the compilation database of the analyzed code.
+
+        The database is mapped into the container (see utils/compilation_database.py)
+        and written to the results directory. A database without translation units in
+        the analyzed code is ignored, so that all files are parsed as without one.
+
+        Returns:
+            List[str]: The arguments, empty if there is no usable compilation database
+        """
+        self.translation_units = []
+        self.database_entries = []
+        if not self.code_path or not self.results_path:
+            return []
+        database_file = self.code_path / ANALYSIS_SETTINGS["compilation_database"]
+        if not database_file.is_file():
+            return []
+
+        database = self.file_handler.read_json(database_file)
+        app_path = self.container_code_path
+        entries, stats = prepare_compilation_database(self.code_path, database, app_path)
+        logger.info(f"Compilation database {database_file.name}: {stats}")
+        if not entries:
+            logger.warning(f"No translation units of {database_file.name} found in the code, parsing all files")
+            return []
+
+        self.file_handler.write_json(entries, self.results_path / "compile_commands.json")
+        self.database_entries = entries
+        self.translation_units = sorted(str(PurePosixPath(entry["file"]).relative_to(app_path)) for entry in entries)
+        self.timings.record_count("translation_units", stats["translation_units"])
+        self.timings.record_count("compile_flag_sets", stats["flag_sets"])
+        return ["--compilation-database", f"{self.container_results_path}/compile_commands.json"]
+
+    def _analysis_command(self, cpg_files: List[str], timeout: int) -> str:
+        """
+        Get the shell command running the Joern analysis script.
+
+        In signatures mode, the script omits the code of the functions and the operator
+        calls. The script reads the code from CODE_DIR and writes the results to
+        RESULTS_DIR. Joern runs in the scratch space, where it keeps its workspace copy
+        of each CPG, and is killed inside the container when it times out.
+
+        Args:
+            cpg_files (List[str]): Container paths of the CPGs to analyze
+            timeout (int): Timeout in seconds
+
+        Returns:
+            str: The shell command
+        """
+        command = [
+            "env",
+            f"ANALYSIS_MODE={self.mode}",
+            f"CPG_FILES={','.join(cpg_files)}",
+            f"CODE_DIR={self.container_code_path}",
+            f"RESULTS_DIR={self.container_results_path}",
+            *(["PARSE_REPORT=1"] if self.parse_report else []),
+            "timeout",
+            "-s",
+            "KILL",
+            str(timeout),
+            "/opt/joern/joern-cli/joern",
+            *[f"-J{opt}" for opt in self._java_opts() + self._profiling_opts("joern")],
+            "--script",
+            f"{CONTAINER_PATHS['scripts']}/analysis.sc",
+        ]
+        return f"cd {self.cpg_path} && {shlex.join(command)}"
 
     def _run_analysis(self) -> bool:
         """
-        Run the Joern analysis script on the imported code.
+        Run the Joern analysis script on the imported CPGs in its own docker exec.
 
         Executes the analysis script to extract function information and
-        generate the call graph from the CPG.
+        generate the call graph from the CPGs.
 
         Returns:
             bool: True if analysis completed successfully, False otherwise
         """
         logger.debug("Running analysis script...")
 
-        container_paths = cast(Dict[str, str], CONTAINER_PATHS)
-        results_path = container_paths["results"]
-        scripts_path = container_paths["scripts"]
-
-        # Create command as a list of strings
-        command: List[str] = [
-            "sh",
-            "-c",
-            f"cd {results_path} && /opt/joern/joern-cli/joern --script {scripts_path}/analysis.sc",
-        ]
+        timeout = self._remaining(ANALYSIS_SETTINGS["timeout"]["command_execution"])
+        if timeout < 1:
+            logger.error("Job deadline passed before the analysis script could run")
+            return False
 
-        success, stdout, stderr = self.docker_manager.execute_command(
-            command,
-            timeout=ANALYSIS_SETTINGS["timeout"]["command_execution"],
-        )
+        command = ["sh", "-c", self._analysis_command(self.cpg_files, timeout)]
+        success, stdout, stderr = self.docker_manager.execute_command(command, timeout=timeout + 30)
 
         if not success:
             logger.error(f"Failed to run analysis script: {stderr}")
+            self._check_scratch_space(stdout + stderr)
             return False
 
         return True
 
+    def _collect_frontend_report(self, output: str) -> None:
+        """
+        Keep the per-file report rows of c2cpg output, without the rest of the debug log.
+
+        Args:
+            output (str): Standard output and error of a c2cpg run
+        """
+        if self.parse_report:
+            self.frontend_report.update(parse_frontend_report(output, self.container_code_path))
+
+    def _write_parse_report(self) -> None:
+        """
+        Write the parse cost of every source file to parse_report.json.
+
+        The per-file report c2cpg logged is combined with the method and node counts
+        analysis.sc wrote to file_nodes.json, which is removed afterwards. Nothing is
+        written if neither is available.
+        """
+        if not self.results_path:
+            return
+
+        file_nodes_file = self.results_path / "file_nodes.json"
+        file_nodes = self.file_handler.read_json(file_nodes_file) if file_nodes_file.exists() else []
+        file_nodes_file.unlink(missing_ok=True)
+        report = build_parse_report(self.frontend_report, file_nodes, self.container_code_path)
+        if not report:
+            logger.debug("No per-file parse cost available")
+            return
+
+        self.file_handler.write_json(report, self.results_path / "parse_report.json")
+        self.timings.record_count("parse_report_files", len(report))
+        logger.info(
+            f"Most expensive file to parse: {report[0]['file']} ({report[0]['seconds']} s, {report[0]['nodes']} nodes)"
+        )
+
+    def _start_resource_sampler(self) -> None:
+        """
+        Start sampling the cgroup counters of the container.
+
+        Every sample is recorded in the run timings and timings.json is rewritten, so
+        that the status of a running job shows its resource usage so far.
+        """
+        results_path = self.results_path
+
+        def on_sample(usage: Dict[str, float]) -> None:
+            self.timings.record_resources(usage)
+            # The results directory is created by the directory setup phase
+            if results_path and results_path.is_dir():
+                self.timings.save(results_path / "timings.json")
+
+        # A container kept running in batch mode has counted the earlier jobs
+        self.resource_sampler = ResourceSampler(
+            self.docker_manager,
+            ANALYSIS_SETTINGS["resource_sampling_interval"],
+            on_sample,
+            relative=self.code_root is not None,
+        )
+        self.resource_sampler.start()
+
+    def _stop_resource_sampler(self) -> None:
+        """
+        Stop sampling, record the resource usage of the job and save the timeline.
+
+        The usage is cumulative over the container lifetime, or since the start of the
+        job in batch mode, and is stored in the resources of timings.json; the timeline
+        of samples is saved as resources.json.
+        """
+        if not self.resource_sampler:
+            return
+
+        self.resource_sampler.stop()
+        self.timings.record_resources(self.resource_sampler.usage)
+        if self.results_path:
+            self.file_handler.write_json(self.resource_sampler.to_dict(), self.results_path / "resources.json")
+        self.resource_sampler = None
+
+    def _profiling_opts(self, run: str) -> List[str]:
+        """
+        Get the JVM options that record a run with Java Flight Recorder.
+
+        Args:
+            run (str): Name of the run, one of PROFILED_RUNS
+
+        Returns:
+            List[str]: The JVM options, empty if profiling is disabled
+        """
+        if not self.profile:
+            return []
+
+        results_path = self.container_results_path
+        jfr_settings = ANALYSIS_SETTINGS["profiling"]["jfr_settings"]
+        return [
+            f"-XX:StartFlightRecording=filename={results_path}/profiles/{run}.jfr,settings={jfr_settings},dumponexit=true"
+        ]
+
+    def _summarize_profiles(self) -> None:
+        """
+        Summarize the JFR recordings of the profiled runs in profile_summary.json.
+
+        The recordings are converted to JSON with the JDK jfr tool in the container,
+        summarized and the intermediate JSON files are removed. Runs without a
+        recording (e.g. because an earlier phase failed) are skipped. Failures are
+        logged and never fail the analysis.
+        """
+        if not self.results_path:
+            return
+
+        results_path = self.container_results_path
+        profiles_path = self.results_path / "profiles"
+        summary: Dict[str, Any] = {}
+        for run in self.PROFILED_RUNS:
+            if not (profiles_path / f"{run}.jfr").exists():
+                continue
+
+            recording = f"{results_path}/profiles/{run}.jfr"
+            events_file = profiles_path / f"{run}.json"
+            events = ",".join(JFR_PRINT_EVENTS)
+            command: List[str] = [
+                "sh",
+                "-c",
+                f"${{JAVA_HOME:+$JAVA_HOME/bin/}}jfr print --json --stack-depth 1 --events {events} {recording}"
+                f" > {results_path}/profiles/{run}.json",
+            ]
+            success, stdout, stderr = self.docker_manager.execute_command(
+                command,
+                timeout=ANALYSIS_SETTINGS["timeout"]["command_execution"],
+            )
+            if not success:
+                logger.warning(f"Failed to convert JFR recording {recording}: {stderr}")
+                continue
+
+            summary[run] = summarize_recording(self.file_handler.read_json(events_file))
+            events_file.unlink(missing_ok=True)
+
+        self.file_handler.write_json(summary, self.results_path / "profile_summary.json")
+        logger.info(f"Profiles written to {profiles_path}")
+
     def _process_results(self) -> None:
         """
         Process and save the analysis results.
@@ -291,28 +1113,32 @@ class JoernAnalyzer:
             return
 
         try:
-            # Read and process function information
-            functions_file = self.results_path / "functions.json"
-            if functions_file.exists() and functions_file.stat().st_size > 0:
-                with open(functions_file) as f:
-                    functions_data = json.load(f)
-                    if isinstance(functions_data, list):
-                        self.functions_info = functions_data
-                    elif isinstance(functions_data, dict):
-                        self.functions_info = [functions_data]
-
-            # Read and process call graph
-            callgraph_file = self.results_path / "call_graph.json"
-            if callgraph_file.exists() and callgraph_file.stat().st_size > 0:
-                with open(callgraph_file) as f:
-                    callgraph_data = json.load(f)
-                    if isinstance(callgraph_data, list):
-                        self.call_graph = callgraph_data
-                    elif isinstance(callgraph_data, dict):
-                        self.call_graph = [callgraph_data]
-
-            # Save raw results
-            self.results_processor.save_raw_results(self.functions_info, self.call_graph)
+            with self.timings.phase("read_results"):
+                # Read and process function information
+                functions_file = self.results_path / "functions.json"
+                if functions_file.exists() and functions_file.stat().st_size > 0:
+                    with open(functions_file) as f:
+                        functions_data = json.load(f)
+                        if isinstance(functions_data, list):
+                            self.functions_info = functions_data
+                        elif isinstance(functions_data, dict):
+                            self.functions_info = [functions_data]
+
+                # Read and process call graph
+                callgraph_file = self.results_path / "call_graph.json"
+                if callgraph_file.exists() and callgraph_file.stat().st_size > 0:
+                    with open(callgraph_file) as f:
+                        callgraph_data = json.load(f)
+                        if isinstance(callgraph_data, list):
+                            self.call_graph = callgraph_data
+                        elif isinstance(callgraph_data, dict):
+                            self.call_graph = [callgraph_data]
+
+                # Save raw results
+                self.results_processor.save_raw_results(self.functions_info, self.call_graph)
+
+            self.timings.record_count("functions", len(self.functions_info))
+            self.timings.record_count("calls", len(self.call_graph))
 
             # Clean and format results
             self.results_processor.clean_and_format_results()
@@ -322,9 +1148,49 @@ class JoernAnalyzer:
             raise RuntimeError(f"Failed to process results: {str(e)}")
 
 
-@click.command()
+class DefaultCommandGroup(click.Group):
+    """Command group that runs the analyze command when no command is given, so that
+    `joern_analyzer.py [options] <path>` keeps working."""
+
+    def parse_args(self, ctx: click.Context, args: List[str]) -> List[str]:
+        if args and args[0] not in self.commands and args[0] != "--help":
+            args = ["analyze", *args]
+        return super().parse_args(ctx, args)
+
+
+def analysis_options(function: Any) -> Any:
+    """Add the options shared by the analyze and batch commands."""
+    options = [
+        click.option(
+            "--profile", is_flag=True, default=False, help="Record c2cpg and the analysis with Java Flight Recorder"
+        ),
+        click.option(
+            "--mode",
+            type=click.Choice(ANALYSIS_MODES),
+            default=None,
+            help="Full analysis, or an index of the function signatures and calls only [default: from settings.py]",
+        ),
+        click.option(
+            "--backend",
+            type=click.Choice(["docker", "offline"]),
+            default=None,
+            help="Run Joern in Docker, or replay or synthesize its output offline [default: from settings.py]",
+        ),
+    ]
+    for option in reversed(options):
+        function = option(function)
+    return function
+
+
+@click.group(cls=DefaultCommandGroup)
+def main() -> None:
+    """Analyze C/C++ code using Joern and generate function information and call graph."""
+
+
+@main.command("analyze")
 @click.argument("code_path", type=click.Path(exists=True, file_okay=False, dir_okay=True, resolve_path=True))
-def main(code_path: str) -> None:
+@analysis_options
+def analyze_command(code_path: str, profile: bool, mode: Optional[str], backend: Optional[str]) -> None:
     """
     Analyze C/C++ code using Joern and generate function information and call graph.
 
@@ -334,12 +1200,17 @@ def main(code_path: str) -> None:
 
     Args:
         code_path (str): Path to the directory containing C/C++ source code to analyze
+        profile (bool): Record c2cpg and the analysis with Java Flight Recorder
+        mode (Optional[str]): "full" or "signatures"
+        backend (Optional[str]): "docker" or "offline"
 
     The results are stored in a directory structure:
     ./results/<code_path_hash>/
         - functions.json: Function information
         - call_graph.json: Call graph representation
         - processed_results/: Cleaned and formatted analysis results
+        - profiles/: JFR recordings, with --profile
+        - profile_summary.json: Summary of the JFR recordings, with --profile
     """
     try:
         code_path_abs = Path(code_path).resolve()
@@ -351,7 +1222,7 @@ def main(code_path: str) -> None:
         logger.info(f"Code path: {code_path_abs}")
         logger.info(f"Results directory: {results_dir}")
 
-        analyzer = JoernAnalyzer()
+        analyzer = JoernAnalyzer(profile=profile or None, backend=backend, mode=mode)
         analyzer.analyze(code_path_abs, results_dir)
 
     except Exception as e:
@@ -359,5 +1230,216 @@ def main(code_path: str) -> None:
         sys.exit(1)
 
 
+def read_batch_paths(args: List[str]) -> List[Path]:
+    """
+    Get the code directories of a batch from the command line.
+
+    Args:
+        args (List[str]): Directories, or "@<file>" for a file listing one directory per
+            line; blank lines and lines starting with "#" are ignored, and relative
+            paths are relative to the working directory
+
+    Returns:
+        List[Path]: The resolved directories, without duplicates
+
+    Raises:
+        click.BadParameter: If a list file or directory does not exist
+    """
+    entries: List[str] = []
+    for arg in args:
+        if arg.startswith("@"):
+            try:
+                lines = Path(arg[1:]).read_text().splitlines()
+            except OSError as e:
+                raise click.BadParameter(f"Cannot read list file {arg[1:]}: {e}") from e
+            entries += [line.strip() for line in lines if line.strip() and not line.strip().startswith("#")]
+        else:
+            entries.append(arg)
+
+    paths: List[Path] = []
+    for entry in entries:
+        path = Path(entry).resolve()
+        if not path.is_dir():
+            raise click.BadParameter(f"Not a directory: {entry}")
+        if path not in paths:
+            paths.append(path)
+    return paths
+
+
+def batch_code_root(code_paths: List[Path], root: Optional[Path] = None) -> Path:
+    """
+    Get the directory of a batch that is mounted into the containers.
+
+    Args:
+        code_paths (List[Path]): Resolved code directories
+        root (Optional[Path]): Directory given on the command line; by default the
+            common root of the code directories
+
+    Returns:
+        Path: The resolved directory
+
+    Raises:
+        click.BadParameter: If a code directory is not inside the given directory, the
+            directory is /, or the common root is less than MIN_BATCH_ROOT_DEPTH levels
+            below /
+    """
+    if root is not None:
+        root = root.resolve()
+        outside = [str(code_path) for code_path in code_paths if not code_path.is_relative_to(root)]
+        if outside:
+            raise click.BadParameter(f"Not inside the root {root}: {', '.join(outside)}")
+    else:
+        root = Path(os.path.commonpath(code_paths))
+        if len(root.parts) - 1 < MIN_BATCH_ROOT_DEPTH:
+            raise click.BadParameter(
+                f"The common root {root} of the code directories would be mounted into the containers: "
+                f"move them into a common directory, or pass it as --root"
+            )
+    if root == Path(root.anchor):
+        raise click.BadParameter("The root / would mount the whole host into the containers")
+    return root
+
+
+def run_batch(
+    code_paths: List[Path],
+    jobs: int,
+    profile: Optional[bool] = None,
+    backend: Optional[str] = None,
+    mode: Optional[str] = None,
+    code_root: Optional[Path] = None,
+) -> List[Dict[str, Any]]:
+    """
+    Analyze many code directories with a pool of workers.
+
+    Each worker analyzes the next pending directory with its own analyzer, whose
+    container is started for the first job and kept running until the pending
+    directories are done (see the code_root of JoernAnalyzer). The jobs still wait for
+    their CPUs and memory like every analysis, so more workers than fit on the host
+    only queue.
+
+    Args:
+        code_paths (List[Path]): Resolved code directories
+        jobs (int): Number of workers
+        profile (Optional[bool]): Record the analyses with Java Flight Recorder
+        backend (Optional[str]): "docker" or "offline"
+        mode (Optional[str]): "full" or "signatures"
+        code_root (Optional[Path]): Directory mounted into the containers, see
+            batch_code_root()
+
+    Returns:
+        List[Dict[str, Any]]: Summary of each analysis, in the order of code_paths
+
+    Raises:
+        click.BadParameter: If the directory to mount is too broad, see batch_code_root()
+    """
+    code_root = batch_code_root(code_paths, code_root)
+    pending: "queue.Queue[Path]" = queue.Queue()
+    for code_path in code_paths:
+        pending.put(code_path)
+    summaries: Dict[Path, Dict[str, Any]] = {}
+
+    def worker() -> None:
+        analyzer = JoernAnalyzer(profile=profile, backend=backend, mode=mode, code_root=code_root)
+        try:
+            while True:
+                try:
+                    code_path = pending.get_nowait()
+                except queue.Empty:
+                    return
+                start = time.perf_counter()
+                error = None
+                try:
+                    analyzer.analyze(code_path)
+                except Exception as e:
+                    logger.error(f"Error analyzing {code_path}: {str(e)}")
+                    error = str(e)
+                summaries[code_path] = {
+                    "code_path": str(code_path),
+                    "status": analyzer.timings.status,
+                    "functions": len(analyzer.functions_info),
+                    "calls": len(analyzer.call_graph),
+                    "skipped_files": len(analyzer.skipped_files),
+                    "seconds": round(time.perf_counter() - start, 2),
+                    "results_path": str(analyzer.results_path),
+                    "error": error,
+                }
+        finally:
+            analyzer.close()
+
+    with ThreadPoolExecutor(max_workers=jobs, thread_name_prefix="batch") as executor:
+        for future in [executor.submit(worker) for _ in range(min(jobs, len(code_paths)))]:
+            future.result()
+    return [summaries[code_path] for code_path in code_paths]
+
+
+def format_batch_summary(summaries: List[Dict[str, Any]]) -> str:
+    """
+    Format the summaries of a batch as a table.
+
+    Args:
+        summaries (List[Dict[str, Any]]): Summaries returned by run_batch()
+
+    Returns:
+        str: The table, one line per analysis
+    """
+    columns = ["status", "functions", "calls", "skipped_files", "seconds", "code_path"]
+    rows = [[column.upper() for column in columns]]
+    rows += [[str(summary[column]) for column in columns] for summary in summaries]
+    widths = [max(len(row[index]) for row in rows) for index in range(len(columns) - 1)]
+    return "\n".join(
+        "  ".join([*(row[index].ljust(width) for index, width in enumerate(widths)), row[-1]]) for row in rows
+    )
+
+
+@main.command("batch")
+@click.argument("code_paths", nargs=-1, required=True)
+@click.option(
+    "--jobs", "-j", type=click.IntRange(min=1), default=4, show_default=True, help="Number of concurrent analyses"
+)
+@click.option(
+    "--root",
+    type=click.Path(exists=True, file_okay=False, path_type=Path),
+    help="Directory containing the code directories to mount into the containers (default: their common root)",
+)
+@analysis_options
+def batch_command(
+    code_paths: Tuple[str, ...],
+    jobs: int,
+    root: Optional[Path],
+    profile: bool,
+    mode: Optional[str],
+    backend: Optional[str],
+) -> None:
+    """
+    Analyze many code directories, given as paths or as @<file> listing one per line.
+
+    The analyses run in a pool of workers that each keep a container running between
+    their jobs. The results of each directory are stored like those of the analyze
+    command; a summary table is printed and saved as ./results/batch_summary.json.
+    The exit code is 1 if any analysis failed.
+
+    \f
+    Args:
+        code_paths (Tuple[str, ...]): Code directories and list files
+        jobs (int): Number of concurrent analyses
+        root (Optional[Path]): Directory to mount instead of the common root of the code
+        profile (bool): Record c2cpg and the analyses with Java Flight Recorder
+        mode (Optional[str]): "full" or "signatures"
+        backend (Optional[str]): "docker" or "offline"
+    """
+    paths = read_batch_paths(list(code_paths))
+    code_root = batch_code_root(paths, root)
+    logger.info(f"Analyzing {len(paths)} code directories under {code_root} with {jobs} workers")
+    summaries = run_batch(paths, jobs, profile=profile or None, backend=backend, mode=mode, code_root=code_root)
+
+    summary_file = Path.cwd() / "results" / "batch_summary.json"
+    FileHandler.write_json(summaries, summary_file)
+    click.echo(format_batch_summary(summaries))
+    logger.info(f"Batch summary saved to {summary_file}")
+
+    if any(summary["status"] == "failure" for summary in summaries):
+        sys.exit(1)
+
+
 if __name__ == "__main__":
     main()
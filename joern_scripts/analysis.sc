@@ -22,11 +22,49 @@ def writeJsonToFile[T](data: T, filePath: String)(implicit formats: Formats): Un
   }
 }
 
+// The analyzer passes the container directories of the code and the results of the job,
+// which are not /app and /results in batch mode
+val codeDir = sys.env.getOrElse("CODE_DIR", "/app")
+val resultsDir = sys.env.getOrElse("RESULTS_DIR", "/results")
+
+// Tracing: the analyzer passes the trace context of the docker exec span in TRACEPARENT
+// (W3C format "00-<trace id>-<span id>-<flags>"). Each traced step is recorded as a
+// child span and written to spans.json in the results, which the analyzer imports into the trace.
+val traceparent: Option[Array[String]] = sys.env.get("TRACEPARENT").map(_.split("-")).filter(_.length == 4)
+val spans = scala.collection.mutable.ListBuffer[Map[String, Any]]()
+
+def nowUnixNano(): Long = {
+  val now = java.time.Instant.now()
+  now.getEpochSecond * 1000000000L + now.getNano
+}
+
+def traced[T](name: String)(body: => T): T = {
+  val start = nowUnixNano()
+  var error = true
+  try {
+    val result = body
+    error = false
+    result
+  } finally {
+    traceparent.foreach { parts =>
+      spans += Map(
+        "traceId" -> parts(1),
+        "spanId" -> f"${scala.util.Random.nextLong()}%016x",
+        "parentSpanId" -> parts(2),
+        "name" -> name,
+        "startTimeUnixNano" -> start.toString,
+        "endTimeUnixNano" -> nowUnixNano().toString,
+        "error" -> error
+      )
+    }
+  }
+}
+
 // Get the full method code by reading the file directly since joern truncates the .code at 1000 chars
 def extractFunctions(): List[Map[String, Any]] = {
   cpg.method.map { method =>
     val code = method.file.name.headOption.map { fileName =>
-      val file = new java.io.File(s"/app/$fileName")
+      val file = new java.io.File(s"$codeDir/$fileName")
       if (file.exists()) {
         val source = scala.io.Source.fromFile(file)
         try {
@@ -52,6 +90,31 @@ def extractFunctions(): List[Map[String, Any]] = {
   }.toList
 }
 
+// Signatures-only mode: the defined functions without their code, for a lightweight index.
+// The <global> method of the <includes> pseudo file has no code of its own and is skipped.
+def extractSignatures(): List[Map[String, Any]] = {
+  cpg.method.isExternal(false).map { method =>
+    Map(
+      "name" -> method.name,
+      "file" -> method.file.name.headOption.getOrElse("<unknown>"),
+      "lineNumber" -> method.lineNumber.getOrElse(-1),
+      "signature" -> method.signature
+    )
+  }.filterNot(_("file") == "<includes>").toList
+}
+
+// Signatures-only mode: calls without operators, which the results processing drops anyway
+def extractCalls(): List[Map[String, Any]] = {
+  cpg.call.nameNot("<operator>.*").map { call =>
+    Map(
+      "name" -> call.name,
+      "method" -> call.method.name,
+      "file" -> call.file.name.headOption.getOrElse("<unknown>"),
+      "lineNumber" -> call.lineNumber.getOrElse(-1)
+    )
+  }.toList
+}
+
 def extractCallGraph(): List[Map[String, Any]] = {
   cpg.call.map { call =>
     Map(
@@ -63,15 +126,61 @@ def extractCallGraph(): List[Map[String, Any]] = {
   }.toList
 }
 
+// Number of methods and AST nodes of every file, for the parse cost report of the analyzer
+def extractFileNodes(): List[Map[String, Any]] = {
+  cpg.method.isExternal(false).l.groupBy(_.filename).map { case (fileName, methods) =>
+    Map(
+      "file" -> fileName,
+      "methods" -> methods.size,
+      "nodes" -> methods.map(_.ast.size).sum
+    )
+  }.toList
+}
+
+// The analyzer passes the analysis mode in ANALYSIS_MODE, "full" or "signatures"
+val signaturesOnly = sys.env.get("ANALYSIS_MODE").contains("signatures")
+
+// The analyzer sets PARSE_REPORT when it reports the parse cost of every file; the
+// signatures index never walks the function bodies for it
+val parseReport = sys.env.contains("PARSE_REPORT") && !signaturesOnly
+
+// The analyzer passes the CPGs in CPG_FILES: one, or one per chunk of files when it
+// isolated files c2cpg failed on. Headers are parsed into every CPG that includes them,
+// so the records of a file are taken from the first CPG that contains it.
+val cpgFiles = sys.env.get("CPG_FILES").map(_.split(",").toList.filter(_.nonEmpty)).getOrElse(List(s"$resultsDir/cpg.bin"))
+
 // Main execution
 try {
-  importCpg("/results/cpg.bin")
-  
   // Use DefaultFormats with no custom serialization
   implicit val formats: Formats = DefaultFormats
-  
-  writeJsonToFile(extractFunctions(), "/results/functions.json")
-  writeJsonToFile(extractCallGraph(), "/results/call_graph.json")
+
+  try {
+    val functions = scala.collection.mutable.ListBuffer[Map[String, Any]]()
+    val calls = scala.collection.mutable.ListBuffer[Map[String, Any]]()
+    val fileNodes = scala.collection.mutable.ListBuffer[Map[String, Any]]()
+    val seenFiles = scala.collection.mutable.Set[Any]()
+    def fromNewFiles(records: List[Map[String, Any]]): List[Map[String, Any]] =
+      records.filterNot(record => seenFiles.contains(record("file")))
+
+    cpgFiles.foreach { cpgFile =>
+      traced("joern.import_cpg") { importCpg(cpgFile) }
+      traced("joern.extract_functions") {
+        functions ++= fromNewFiles(if (signaturesOnly) extractSignatures() else extractFunctions())
+      }
+      traced("joern.extract_call_graph") {
+        calls ++= fromNewFiles(if (signaturesOnly) extractCalls() else extractCallGraph())
+      }
+      if (parseReport) traced("joern.extract_file_nodes") { fileNodes ++= fromNewFiles(extractFileNodes()) }
+      seenFiles ++= cpg.file.name.l
+      close
+    }
+
+    writeJsonToFile(functions.toList, s"$resultsDir/functions.json")
+    writeJsonToFile(calls.toList, s"$resultsDir/call_graph.json")
+    if (parseReport) writeJsonToFile(fileNodes.toList, s"$resultsDir/file_nodes.json")
+  } finally {
+    if (traceparent.isDefined) writeJsonToFile(spans.toList, s"$resultsDir/spans.json")
+  }
 } catch {
   case e: Exception =>
     println(s"Error during analysis: ${e.getMessage}")
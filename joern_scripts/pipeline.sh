@@ -0,0 +1,27 @@
+#!/bin/sh
+# Analysis pipeline: runs the stages of an analysis job in a single docker exec.
+#
+# Usage: pipeline.sh <events file> <name>=<command> ...
+#
+# Each stage is a shell command line. The stages run in order until one fails, with
+# their output passed through. When a stage completes, a JSON line is appended to the
+# events file:
+#   {"stage": "<name>", "exit_code": <code>, "milliseconds": <duration>}
+# The exit code of the pipeline is that of the failed stage, or 0.
+
+events=$1
+shift
+: > "$events"
+
+now_ms() {
+  echo $(( $(date +%s%N) / 1000000 ))
+}
+
+for stage in "$@"; do
+  name=${stage%%=*}
+  start=$(now_ms)
+  sh -c "${stage#*=}"
+  code=$?
+  printf '{"stage": "%s", "exit_code": %d, "milliseconds": %d}\n' "$name" "$code" "$(( $(now_ms) - start ))" >> "$events"
+  [ "$code" -eq 0 ] || exit "$code"
+done
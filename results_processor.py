@@ -8,17 +8,50 @@ The module supports:
 - Cleaning and filtering function data
 - Processing call graphs
 - Converting call graphs to tree structures
+- Computing recursion cycles (strongly connected components) of the call graph
+- Computing call depths and dominator trees for the entry points
+- Detecting dead functions that are unreachable from the entry points
+- Building a reachability index over the call graph
+- Building a trigram search index over function signatures and bodies
+- Diffing the call graphs of two analyses
+- Exporting the call graph to DOT, GraphML and Neo4j bulk-import CSV
+- Recording calls to functions that are not defined in the analyzed code
+- Timing each processing step and recording output sizes and counts
 - Saving results in various formats (JSON and text)
 """
 
+import json
+import os
+import uuid
 from collections import defaultdict
+from functools import lru_cache
 from pathlib import Path
-from typing import Any, Dict, List, NamedTuple, Set
+from typing import Any, Dict, Iterator, List, NamedTuple, Optional, Set, cast
 
 from loguru import logger
 
-from settings import SYSTEM_FUNCTIONS
+from settings import ANALYSIS_SETTINGS, SYSTEM_FUNCTIONS
+from utils.call_graph import CallGraph
 from utils.file_handler import FileHandler
+from utils.graph_diff import Shard, diff_shards, shard_results
+from utils.graph_export import iter_dot, iter_graphml, iter_neo4j_edges, iter_neo4j_nodes
+from utils.metrics import RunTimings
+from utils.reachability import ReachabilityIndex
+from utils.trigram_index import TrigramIndex
+
+
+@lru_cache(maxsize=64)
+def _load_search_index(search_index: Path, mtime_ns: int) -> TrigramIndex:
+    """Load a search index, cached until the file is rewritten.
+
+    Args:
+        search_index (Path): The search index file
+        mtime_ns (int): Modification time of the file, part of the cache key
+
+    Returns:
+        TrigramIndex: The index
+    """
+    return TrigramIndex.from_dict(cast(Dict[str, Any], FileHandler.read_json(search_index)))
 
 
 class ResultPaths(NamedTuple):
@@ -29,6 +62,14 @@ class ResultPaths(NamedTuple):
     call_graph: Path
     call_graph_clean: Path
     call_graph_tree: Path
+    components: Path
+    entry_points: Path
+    dead_functions: Path
+    reachability_index: Path
+    search_index: Path
+    unresolved_calls: Path
+    skipped_files: Path
+    timings: Path
 
 
 class ResultsProcessor:
@@ -40,16 +81,26 @@ class ResultsProcessor:
     Attributes:
         results_path (Path): Path to the directory where results will be saved
         file_handler (FileHandler): Instance of FileHandler for file operations
+        entry_points (List[str]): Functions the call graph analyses start from
+        timings (RunTimings): Timings of the processing steps
     """
 
-    def __init__(self, results_path: Path):
+    def __init__(
+        self, results_path: Path, entry_points: Optional[List[str]] = None, timings: Optional[RunTimings] = None
+    ):
         """Initialize the ResultsProcessor.
 
         Args:
             results_path (Path): Path to the directory where results will be saved
+            entry_points (Optional[List[str]]): Functions the call graph analyses start
+                from; defaults to the entry points in ANALYSIS_SETTINGS
+            timings (Optional[RunTimings]): Timings of the analysis run the processing
+                steps belong to; defaults to new timings
         """
         self.results_path = results_path
         self.file_handler = FileHandler()
+        self.entry_points = list(ANALYSIS_SETTINGS["entry_points"] if entry_points is None else entry_points)
+        self.timings = RunTimings() if timings is None else timings
 
     def _get_result_paths(self) -> ResultPaths:
         """Get all result file paths.
@@ -63,6 +114,14 @@ class ResultsProcessor:
             call_graph=self.results_path / "call_graph.json",
             call_graph_clean=self.results_path / "call_graph_clean.json",
             call_graph_tree=self.results_path / "call_graph_tree.txt",
+            components=self.results_path / "components.json",
+            entry_points=self.results_path / "entry_points.json",
+            dead_functions=self.results_path / "dead_functions.json",
+            reachability_index=self.results_path / "reachability_index.json",
+            search_index=self.results_path / "search_index.json",
+            unresolved_calls=self.results_path / "unresolved_calls.json",
+            skipped_files=self.results_path / "skipped_files.json",
+            timings=self.results_path / "timings.json",
         )
 
     def _get_known_functions(self, functions_file: Path) -> Set[str]:
@@ -78,13 +137,23 @@ class ResultsProcessor:
             Set[str]: Set of valid function names
         """
         functions = self.file_handler.read_json(functions_file)
-        return {
-            func["name"]
-            for func in functions
-            if func.get("code")
-            and func.get("code") not in ["<empty>", "<global>"]
-            and not func.get("name", "").startswith("<operator>")
-        }
+        return {func["name"] for func in functions if self._is_defined(func)}
+
+    def _is_defined(self, func: Dict[str, Any]) -> bool:
+        """Check if a function entry is a function defined in the analyzed code.
+
+        Functions of a signatures-only index have no code; the analysis script only
+        writes the defined ones.
+
+        Args:
+            func (Dict[str, Any]): The function entry
+
+        Returns:
+            bool: False for empty functions, global scopes and operator functions
+        """
+        if "code" in func and (not func["code"] or func["code"] in ["<empty>", "<global>"]):
+            return False
+        return not func.get("name", "").startswith("<operator>")
 
     def _is_system_function(self, name: str) -> bool:
         """Check if a function is a common system function.
@@ -97,7 +166,7 @@ class ResultsProcessor:
         """
         return name in SYSTEM_FUNCTIONS
 
-    def clean_functions(self, input_file: Path, output_file: Path) -> None:
+    def clean_functions(self, input_file: Path, output_file: Path) -> int:
         """Clean and format the functions data.
 
         Removes empty functions, global scopes, operator functions, and functions
@@ -106,21 +175,16 @@ class ResultsProcessor:
         Args:
             input_file (Path): Path to the input functions file
             output_file (Path): Path where the cleaned functions will be saved
+
+        Returns:
+            int: Number of cleaned functions
         """
         functions = self.file_handler.read_json(input_file)
 
-        cleaned_functions = [
-            func
-            for func in functions
-            if (
-                func.get("code") not in ["<empty>", "<global>"]
-                and not func.get("name", "").startswith("<operator>")
-                and func.get("code")
-                and func.get("file") != "<unknown>"
-            )
-        ]
+        cleaned_functions = [func for func in functions if self._is_defined(func) and func.get("file") != "<unknown>"]
 
         self.file_handler.write_json(cleaned_functions, output_file)
+        return len(cleaned_functions)
 
     def clean_call_graph(self, input_file: Path, output_file: Path, functions_file: Path) -> None:
         """Clean and format the call graph data.
@@ -147,6 +211,37 @@ class ResultsProcessor:
 
         self.file_handler.write_json(cleaned_calls, output_file)
 
+    def save_unresolved_calls(self, input_file: Path, output_file: Path, functions_file: Path) -> None:
+        """Save the calls to functions that are neither defined in the code nor system functions.
+
+        These are the calls that clean_call_graph() drops. They usually target other
+        libraries and are what the federated index links across code IDs. Every
+        caller and callee pair is kept once, with the location of its first call.
+
+        Args:
+            input_file (Path): Path to the raw call graph file
+            output_file (Path): Path where the unresolved calls will be saved
+            functions_file (Path): Path to the functions file for validation
+        """
+        known_functions = self._get_known_functions(functions_file)
+        calls = self.file_handler.read_json(input_file)
+
+        unresolved: Dict[tuple, Dict[str, Any]] = {}
+        for call in calls:
+            caller, callee = call.get("method", ""), call.get("name", "")
+            if (
+                not callee
+                or callee in known_functions
+                or self._is_system_function(callee)
+                or callee.startswith("<operator>")
+                or "<global>" in (caller, callee)
+                or caller not in known_functions
+            ):
+                continue
+            unresolved.setdefault((caller, callee), call)
+
+        self.file_handler.write_json(sorted(unresolved.values(), key=lambda c: (c["method"], c["name"])), output_file)
+
     def format_call_graph(self, input_file: Path, output_file: Path) -> None:
         """Format the call graph into a tree structure.
 
@@ -191,6 +286,328 @@ class ResultsProcessor:
 
         self.file_handler.write_text("\n".join(output_lines), output_file)
 
+    def load_call_graph(self, call_graph_file: Path, functions_file: Path) -> CallGraph:
+        """Load the call graph into its interned CSR representation.
+
+        Args:
+            call_graph_file (Path): Path to the cleaned call graph file
+            functions_file (Path): Path to the cleaned functions file; every function
+                becomes a node, even if it neither calls nor is called by anything
+
+        Returns:
+            CallGraph: The call graph
+        """
+        functions = self.file_handler.iter_json_array(functions_file)
+        calls = self.file_handler.read_json(call_graph_file)
+        return CallGraph.from_calls(calls, (func["name"] for func in functions if func.get("name")))
+
+    def save_components(self, graph: CallGraph, comp: List[int], output_file: Path) -> None:
+        """Save the strongly connected components and the condensed call graph.
+
+        The output contains:
+        - function_components: Component id of each function
+        - components: Sorted member functions of each component
+        - recursive: Functions that are part of a (mutual) recursion cycle
+        - dag: The condensed call graph in CSR form (offsets and targets), with
+          component ids in reverse topological order
+
+        Args:
+            graph (CallGraph): The call graph
+            comp (List[int]): Component id of each node
+            output_file (Path): Path where the components will be saved
+        """
+        dag = graph.condense(comp)
+        members: List[List[str]] = [[] for _ in range(dag.num_nodes)]
+        for node, component in enumerate(comp):
+            members[component].append(graph.names[node])
+
+        self.file_handler.write_json(
+            {
+                "function_components": {name: comp[node] for node, name in enumerate(graph.names)},
+                "components": [sorted(names) for names in members],
+                "recursive": sorted(graph.names[node] for node in graph.recursive_nodes(comp)),
+                "dag": {"offsets": dag.offsets.tolist(), "targets": dag.targets.tolist()},
+            },
+            output_file,
+        )
+
+    def save_entry_points(self, graph: CallGraph, output_file: Path) -> None:
+        """Save the call depths and dominator trees of the entry points.
+
+        For each entry point defined in the code, the output holds two arrays
+        indexed like "names":
+        - depth: Minimum number of calls from the entry point, -1 if unreachable
+        - idom: Index of the immediate dominator, i.e. the closest function every call
+          chain from the entry point passes through; the entry point is its own
+          immediate dominator and unreachable functions have -1
+
+        Args:
+            graph (CallGraph): The call graph
+            output_file (Path): Path where the results will be saved
+        """
+        reverse = graph.reverse()
+        entry_points: Dict[str, Dict[str, List[int]]] = {}
+        for name in self.entry_points:
+            root = graph.node_id(name)
+            if root is None:
+                logger.warning(f"Entry point {name} not found in call graph")
+                continue
+            entry_points[name] = {
+                "depth": graph.call_depths([root]).tolist(),
+                "idom": graph.dominators(root, reverse).tolist(),
+            }
+
+        self.file_handler.write_json({"names": graph.names, "entry_points": entry_points}, output_file)
+
+    def save_dead_functions(self, graph: CallGraph, functions_file: Path, output_file: Path) -> None:
+        """Save the functions that are unreachable from every entry point.
+
+        Only functions defined in the analyzed code can be dead; if none of the
+        entry points is defined in the code, nothing is reported.
+
+        Args:
+            graph (CallGraph): The call graph
+            functions_file (Path): Path to the cleaned functions file
+            output_file (Path): Path where the dead functions will be saved
+        """
+        roots = [node for node in map(graph.node_id, self.entry_points) if node is not None]
+        if not roots:
+            logger.warning("No entry point found in call graph, skipping dead function detection")
+            self.file_handler.write_json([], output_file)
+            return
+
+        depth = graph.call_depths(roots)
+        dead_functions = [
+            {"name": func["name"], "file": func.get("file"), "lineNumber": func.get("lineNumber")}
+            for func in self.file_handler.read_json(functions_file)
+            if func.get("name") not in (None, "<global>") and depth[graph.ids[func["name"]]] == -1
+        ]
+
+        self.file_handler.write_json(dead_functions, output_file)
+
+    def load_entry_points(self) -> Dict[str, Any]:
+        """Load the call depths and dominator trees from the results directory.
+
+        Returns:
+            Dict[str, Any]: The entry point results as written by save_entry_points()
+
+        Raises:
+            FileNotFoundError: If the entry points have not been processed yet
+        """
+        entry_points_file = self._get_result_paths().entry_points
+        if not entry_points_file.exists():
+            raise FileNotFoundError(f"Entry points not found: {entry_points_file}")
+        return cast(Dict[str, Any], self.file_handler.read_json(entry_points_file))
+
+    def load_status(self) -> Dict[str, Any]:
+        """Load the status, phase timings and resource usage of the last analysis run.
+
+        The timings are rewritten during the run, so a running job reports its phases
+        and resource usage so far.
+
+        Returns:
+            Dict[str, Any]: The run timings as written by RunTimings.save()
+
+        Raises:
+            FileNotFoundError: If no analysis has been started yet
+        """
+        timings_file = self._get_result_paths().timings
+        if not timings_file.exists():
+            raise FileNotFoundError(f"Timings not found: {timings_file}")
+        return cast(Dict[str, Any], self.file_handler.read_json(timings_file))
+
+    def load_components(self) -> Dict[str, Any]:
+        """Load the strongly connected components from the results directory.
+
+        Returns:
+            Dict[str, Any]: The components as written by save_components()
+
+        Raises:
+            FileNotFoundError: If the components have not been computed yet
+        """
+        components_file = self._get_result_paths().components
+        if not components_file.exists():
+            raise FileNotFoundError(f"Components not found: {components_file}")
+        return cast(Dict[str, Any], self.file_handler.read_json(components_file))
+
+    def build_reachability_index(self, graph: CallGraph, comp: List[int], output_file: Path) -> None:
+        """Build the reachability index for the call graph.
+
+        The system functions are used as sinks, so that "can this function reach
+        a dangerous system function" is answered by a single bit test.
+
+        Args:
+            graph (CallGraph): The call graph
+            comp (List[int]): Component id of each node
+            output_file (Path): Path where the index will be saved
+        """
+        settings = ANALYSIS_SETTINGS["reachability"]
+        index = ReachabilityIndex.build(
+            graph, SYSTEM_FUNCTIONS, num_intervals=settings["interval_labels"], seed=settings["seed"], comp=comp
+        )
+
+        self.file_handler.write_json(index.to_dict(), output_file)
+
+    def load_reachability_index(self) -> ReachabilityIndex:
+        """Load the reachability index from the results directory.
+
+        Returns:
+            ReachabilityIndex: The index
+
+        Raises:
+            FileNotFoundError: If the index has not been built yet
+        """
+        index_file = self._get_result_paths().reachability_index
+        if not index_file.exists():
+            raise FileNotFoundError(f"Reachability index not found: {index_file}")
+        return ReachabilityIndex.from_dict(cast(Dict[str, Any], self.file_handler.read_json(index_file)))
+
+    def build_search_index(self, functions_file: Path, output_file: Path) -> None:
+        """Build the trigram search index over function signatures and bodies.
+
+        Args:
+            functions_file (Path): Path to the cleaned functions file
+            output_file (Path): Path where the index will be saved
+        """
+        functions = self.file_handler.read_json(functions_file)
+        self.file_handler.write_json(TrigramIndex.build(functions).to_dict(), output_file)
+
+    def search_functions(self, query: str, regex: bool = False, limit: Optional[int] = None) -> List[Dict[str, Any]]:
+        """Search the cleaned functions for a substring or regular expression.
+
+        Candidates are narrowed down through the search index and then verified
+        against the signature and code in the cleaned functions file. The loaded
+        indexes are kept in memory until their file changes.
+
+        Args:
+            query (str): Substring or regular expression
+            regex (bool): Whether the query is a regular expression
+            limit (Optional[int]): Maximum number of matches to return
+
+        Returns:
+            List[Dict[str, Any]]: Matching functions (name, file, lineNumber, signature)
+
+        Raises:
+            FileNotFoundError: If the search index has not been built yet
+            re.error: If the regular expression is invalid
+        """
+        paths = self._get_result_paths()
+        if not paths.search_index.exists():
+            raise FileNotFoundError(f"Search index not found: {paths.search_index}")
+
+        index = _load_search_index(paths.search_index, paths.search_index.stat().st_mtime_ns)
+        candidates = index.candidates(query, regex)
+        if not candidates:
+            return []
+        functions = self.file_handler.read_json(paths.functions_clean)
+        return index.search(functions, query, regex, limit, candidates)
+
+    def _load_shards(self, results_path: Path) -> Dict[str, Shard]:
+        """Load the cleaned results of an analysis as per-file shards.
+
+        Args:
+            results_path (Path): Results directory of the analysis
+
+        Returns:
+            Dict[str, Shard]: Shard of each source file
+        """
+        paths = ResultsProcessor(results_path)._get_result_paths()
+        return shard_results(
+            self.file_handler.read_json(paths.functions_clean), self.file_handler.read_json(paths.call_graph_clean)
+        )
+
+    def diff_results(self, old_results_path: Path) -> Dict[str, Any]:
+        """Diff the call graph of an older analysis against this one.
+
+        The diff is cached in the diffs/ subdirectory of this results directory and
+        recomputed when either analysis has been processed again since, or when the
+        cached diff cannot be read.
+
+        Args:
+            old_results_path (Path): Results directory of the older analysis
+
+        Returns:
+            Dict[str, Any]: The diff as returned by diff_shards()
+
+        Raises:
+            FileNotFoundError: If either analysis has no cleaned results
+        """
+        paths = self._get_result_paths()
+        old_paths = ResultsProcessor(old_results_path)._get_result_paths()
+        inputs = [paths.functions_clean, paths.call_graph_clean, old_paths.functions_clean, old_paths.call_graph_clean]
+        for input_file in inputs:
+            if not input_file.exists():
+                raise FileNotFoundError(f"Cleaned results not found: {input_file}")
+
+        cache_file = self.results_path / "diffs" / f"{old_results_path.name}.json"
+        if cache_file.exists() and cache_file.stat().st_mtime >= max(f.stat().st_mtime for f in inputs):
+            try:
+                return cast(Dict[str, Any], json.loads(cache_file.read_text()))
+            except ValueError as e:
+                logger.warning(f"Ignoring unreadable diff cache {cache_file}: {str(e)}")
+
+        diff = diff_shards(self._load_shards(old_results_path), self._load_shards(self.results_path))
+        cache_file.parent.mkdir(exist_ok=True)
+        # Concurrent requests for the same pair each write their own file, so the cache
+        # is replaced atomically and never read half-written
+        temp_file = cache_file.with_name(f"{cache_file.name}.{uuid.uuid4().hex[:12]}.tmp")
+        if self.file_handler.write_json(diff, temp_file):
+            os.replace(temp_file, cache_file)
+        else:
+            temp_file.unlink(missing_ok=True)
+        return diff
+
+    def iter_export(self, export_format: str, id_prefix: str = "") -> Iterator[str]:
+        """Export the cleaned call graph, streaming the output line by line.
+
+        The memory used is proportional to the number of functions and calls, which
+        are interned into the CSR graph, but not to the size of the function code.
+
+        Args:
+            export_format (str): One of the keys of graph_export.EXPORT_FORMATS
+            id_prefix (str): Prefix for node ids in the Neo4j CSV files
+
+        Returns:
+            Iterator[str]: Lines of the exported document
+
+        Raises:
+            FileNotFoundError: If the cleaned results have not been written yet
+            ValueError: If the export format is unknown
+        """
+        paths = self._get_result_paths()
+        if not paths.call_graph_clean.exists() or not paths.functions_clean.exists():
+            raise FileNotFoundError(f"Cleaned results not found in {self.results_path}")
+
+        # The functions are parsed one by one, so their code is never held in memory
+        names: List[str] = []
+        node_files: Dict[str, str] = {}
+        for func in self.file_handler.iter_json_array(paths.functions_clean):
+            if func.get("name"):
+                names.append(func["name"])
+                if func.get("file"):
+                    node_files[func["name"]] = func["file"]
+        graph = CallGraph.from_calls(self.file_handler.read_json(paths.call_graph_clean), names)
+
+        if export_format == "dot":
+            return iter_dot(graph, node_files)
+        if export_format == "graphml":
+            return iter_graphml(graph, node_files)
+        if export_format == "neo4j_nodes":
+            return iter_neo4j_nodes(graph, node_files, SYSTEM_FUNCTIONS, id_prefix)
+        if export_format == "neo4j_edges":
+            return iter_neo4j_edges(graph, id_prefix)
+        raise ValueError(f"Unknown export format: {export_format}")
+
+    def export_call_graph(self, export_format: str, output_file: Path, id_prefix: str = "") -> None:
+        """Export the cleaned call graph to a file.
+
+        Args:
+            export_format (str): One of the keys of graph_export.EXPORT_FORMATS
+            output_file (Path): Path where the export will be saved
+            id_prefix (str): Prefix for node ids in the Neo4j CSV files
+        """
+        self.file_handler.write_lines(self.iter_export(export_format, id_prefix), output_file)
+
     def save_raw_results(self, functions_info: List[Dict[str, Any]], call_graph: List[Dict[str, Any]]) -> None:
         """Save raw analysis results to files.
 
@@ -212,15 +629,52 @@ class ResultsProcessor:
         get_all_results() and clean_and_format_results().
         """
         paths = self._get_result_paths()
+        timings = self.timings
 
         # Clean functions
-        self.clean_functions(paths.functions, paths.functions_clean)
+        with timings.phase("clean_functions"):
+            cleaned_functions = self.clean_functions(paths.functions, paths.functions_clean)
 
         # Clean call graph
-        self.clean_call_graph(paths.call_graph, paths.call_graph_clean, paths.functions_clean)
+        with timings.phase("clean_call_graph"):
+            self.clean_call_graph(paths.call_graph, paths.call_graph_clean, paths.functions_clean)
+
+        # Record calls that leave the analyzed code
+        with timings.phase("unresolved_calls"):
+            self.save_unresolved_calls(paths.call_graph, paths.unresolved_calls, paths.functions_clean)
 
         # Format call graph tree
-        self.format_call_graph(paths.call_graph_clean, paths.call_graph_tree)
+        with timings.phase("format_call_graph"):
+            self.format_call_graph(paths.call_graph_clean, paths.call_graph_tree)
+
+        # Compute recursion cycles once and share them with the reachability index
+        with timings.phase("components"):
+            graph = self.load_call_graph(paths.call_graph_clean, paths.functions_clean)
+            comp = graph.strongly_connected_components()
+            self.save_components(graph, comp, paths.components)
+
+        # Compute call depths and dominator trees
+        with timings.phase("entry_points"):
+            self.save_entry_points(graph, paths.entry_points)
+
+        # Detect dead functions
+        with timings.phase("dead_functions"):
+            self.save_dead_functions(graph, paths.functions_clean, paths.dead_functions)
+
+        # Build reachability index
+        with timings.phase("reachability_index"):
+            self.build_reachability_index(graph, comp, paths.reachability_index)
+
+        # Build search index
+        with timings.phase("search_index"):
+            self.build_search_index(paths.functions_clean, paths.search_index)
+
+        # Record output sizes and counts
+        for path in paths:
+            if path != paths.timings:
+                timings.record_size(path)
+        timings.record_count("cleaned_functions", cleaned_functions)
+        timings.record_count("cleaned_calls", graph.num_edges)
 
     def get_all_results(self, functions_info: List[Dict[str, Any]], call_graph: List[Dict[str, Any]]) -> Dict[str, Any]:
         """Get all analysis results in a format suitable for API responses.
@@ -239,22 +693,37 @@ class ResultsProcessor:
                 - cleaned_functions: Cleaned function data
                 - cleaned_call_graph: Cleaned call graph data
                 - call_graph_tree: Formatted call graph tree as list of strings
+                - dead_functions: Functions unreachable from the entry points
         """
-        paths = self._get_result_paths()
-
         # Save raw results
         self.save_raw_results(functions_info, call_graph)
 
         # Process results
         self._process_results()
 
-        # Read all results
+        return self.read_all_results()
+
+    def read_all_results(self) -> Dict[str, Any]:
+        """Read already processed analysis results in a format suitable for API responses.
+
+        Unlike get_all_results(), nothing is saved or processed again, so this is the
+        cheap way to serve results that clean_and_format_results() has just produced.
+
+        Returns:
+            Dict[str, Any]: The same results as get_all_results(), plus "incomplete" and
+                "skipped_files" (the files the analysis skipped, with the reason)
+        """
+        paths = self._get_result_paths()
+        skipped_files = self.file_handler.read_json(paths.skipped_files) if paths.skipped_files.exists() else []
         return {
+            "incomplete": bool(skipped_files),
+            "skipped_files": skipped_files,
             "functions": self.file_handler.read_json(paths.functions),
             "call_graph": self.file_handler.read_json(paths.call_graph),
             "cleaned_functions": self.file_handler.read_json(paths.functions_clean),
             "cleaned_call_graph": self.file_handler.read_json(paths.call_graph_clean),
             "call_graph_tree": self.file_handler.read_text(paths.call_graph_tree).split("\n"),
+            "dead_functions": self.file_handler.read_json(paths.dead_functions),
         }
 
     def clean_and_format_results(self) -> None:
@@ -15,7 +15,7 @@ All settings are typed using TypedDict for better type safety and documentation.
 """
 
 from pathlib import Path
-from typing import Set, TypedDict
+from typing import List, Set, TypedDict
 import shutil
 
 
@@ -34,24 +34,119 @@ class JoernSettings(TypedDict):
     working_dir: str
 
 
+class ContainerLimitSettings(TypedDict):
+    """CPU and memory limits of the Joern containers (see utils/job_scheduler.py).
+
+    The limits of a job are estimated from the size of the analyzed source files, and
+    jobs wait until the host has the CPUs and memory for them.
+
+    Attributes:
+        enabled: Whether to limit the containers and schedule the jobs
+        min_cpus: Minimum number of CPUs of a job
+        max_cpus: Maximum number of CPUs of a job
+        source_bytes_per_cpu: Source size per CPU of a job (bytes)
+        min_memory_mb: Minimum memory of a job (MiB)
+        max_memory_mb: Maximum memory of a job (MiB)
+        memory_per_source_mb: Memory per MiB of source, added to the minimum (MiB)
+        heap_fraction: Share of the container memory given to the JVM heap
+        host_memory_fraction: Share of the host memory available to the jobs
+        pin_cpus: Whether to pin each job to CPUs and the memory of one NUMA node
+            (--cpuset-cpus and --cpuset-mems); the CPU ids are those of the host, so
+            this needs a Linux host running the containers natively. The jobs are
+            packed per process, so only enable it if a single analyzer or API
+            process runs jobs on the host.
+    """
+
+    enabled: bool
+    min_cpus: int
+    max_cpus: int
+    source_bytes_per_cpu: int
+    min_memory_mb: int
+    max_memory_mb: int
+    memory_per_source_mb: int
+    heap_fraction: float
+    host_memory_fraction: float
+    pin_cpus: bool
+
+
+class ScratchSettings(TypedDict):
+    """Scratch space of the Joern containers.
+
+    The CPGs and the Joern workspace are written to a tmpfs in the container instead
+    of the results directory, since only the extracted results are kept.
+
+    Attributes:
+        enabled: Whether to mount the tmpfs; without it, the results directory is used
+        min_size_mb: Minimum size of the tmpfs (MiB)
+        max_size_mb: Maximum size of the tmpfs (MiB)
+        size_per_source_mb: Size of the tmpfs per MiB of source files (MiB), for the
+            CPGs and the Joern workspace copy of each
+
+    The tmpfs is backed by the memory of the container, so its size is added to the
+    memory reserved for the job.
+    """
+
+    enabled: bool
+    min_size_mb: int
+    max_size_mb: int
+    size_per_source_mb: int
+
+
 class DockerSettings(TypedDict):
     """Global Docker configuration settings.
 
     Attributes:
         joern: Joern-specific Docker settings
         docker_executable: Path to the Docker executable
+        backend: "docker" to run Joern in a container, or "offline" to replay or
+            synthesize the Joern output without Docker (see OFFLINE_SETTINGS)
+        limits: CPU and memory limits of the containers
+        scratch: Scratch space of the containers for CPGs and intermediate files
     """
 
     joern: JoernSettings
     docker_executable: str
+    backend: str
+    limits: ContainerLimitSettings
+    scratch: ScratchSettings
 
 
 DOCKER_SETTINGS: DockerSettings = {
     "joern": {"image": "ghcr.io/joernio/joern:nightly", "platform": "linux/amd64", "working_dir": "/app"},
     "docker_executable": shutil.which("docker") or "docker",  # Fallback to "docker" if not found
+    "backend": "docker",
+    "limits": {
+        "enabled": True,
+        "min_cpus": 1,
+        "max_cpus": 8,
+        "source_bytes_per_cpu": 2 * 1024 * 1024,
+        "min_memory_mb": 2048,
+        "max_memory_mb": 16384,
+        "memory_per_source_mb": 200,
+        "heap_fraction": 0.75,
+        "host_memory_fraction": 0.8,
+        "pin_cpus": False,
+    },
+    "scratch": {"enabled": True, "min_size_mb": 1024, "max_size_mb": 16384, "size_per_source_mb": 100},
 }
 
 
+class OfflineSettings(TypedDict):
+    """Settings of the offline backend.
+
+    Attributes:
+        replay: Recorded Joern output to replay for every analysis, either a results
+            file with "functions" and "call_graph" (like test_code/*_results.json) or a
+            directory with functions.json and call_graph.json; empty to synthesize the
+            output of generated codebases and replay <code dir>_results.json otherwise
+    """
+
+    replay: str
+
+
+OFFLINE_SETTINGS: OfflineSettings = {"replay": ""}
+
+
 # Analysis settings
 class TimeoutSettings(TypedDict):
     """Timeout settings for various operations.
@@ -60,11 +155,22 @@ class TimeoutSettings(TypedDict):
         docker_start: Timeout for Docker container startup (seconds)
         command_execution: Timeout for command execution (seconds)
         server_init: Timeout for server initialization (seconds)
+        job: Deadline of a whole analysis run; files not parsed by then are skipped
+            and the results are marked incomplete (seconds)
+        parse_file: Parse time allowed per file when c2cpg is run on chunks of files
+            to isolate the files it fails or hangs on (seconds)
+        parse_startup: Startup time allowed per c2cpg run on a chunk (seconds)
+        analysis_reserve: Part of the job timeout kept for the analysis script and the
+            results processing; c2cpg gets only the time before it (seconds)
     """
 
     docker_start: int
     command_execution: int
     server_init: int
+    job: int
+    parse_file: int
+    parse_startup: int
+    analysis_reserve: int
 
 
 class OutputSettings(TypedDict):
@@ -79,21 +185,120 @@ class OutputSettings(TypedDict):
     call_graph_file: str
 
 
+class ReachabilitySettings(TypedDict):
+    """Reachability index settings.
+
+    Attributes:
+        interval_labels: Number of randomized interval labelings stored in the index
+        seed: Seed for the randomized labelings, so that indexes are reproducible
+    """
+
+    interval_labels: int
+    seed: int
+
+
+class ProfilingSettings(TypedDict):
+    """Java Flight Recorder profiling settings.
+
+    Attributes:
+        enabled: Record c2cpg and the analysis script with JFR by default
+        jfr_settings: JFR settings file of the JDK, "default" (low overhead) or
+            "profile" (more samples, allocation tracking)
+    """
+
+    enabled: bool
+    jfr_settings: str
+
+
 class AnalysisSettings(TypedDict):
     """Analysis configuration settings.
 
     Attributes:
         timeout: Timeout settings for various operations
         output: Output file settings
+        reachability: Reachability index settings
+        profiling: Java Flight Recorder profiling settings
+        resource_sampling_interval: Seconds between samples of the container's
+            cgroup counters during a job
+        parse_report: Run c2cpg with debug logging to report the parse cost of every
+            file in parse_report.json; slows c2cpg down, so disabled by default
+        mode: Default analysis mode, "full" or "signatures" (a lightweight index of the
+            functions and calls, without function bodies; see ANALYSIS_MODES)
+        isolation_chunk_files: Number of files per c2cpg run when isolating the files
+            c2cpg fails or hangs on; failing chunks are split until single files remain
+        isolation_chunk_budget: Largest part of the time left for c2cpg that one chunk
+            run may take, so that a chunk hanging on a file leaves the time to isolate it
+        compilation_database: Path of the compilation database relative to the root
+            of the analyzed code; if it exists, only its translation units are parsed,
+            with their include paths and defines
+        entry_points: Functions to compute call depths and dominator trees for;
+            functions that are not defined in the analyzed code are skipped
     """
 
     timeout: TimeoutSettings
     output: OutputSettings
+    reachability: ReachabilitySettings
+    profiling: ProfilingSettings
+    resource_sampling_interval: float
+    parse_report: bool
+    mode: str
+    isolation_chunk_files: int
+    isolation_chunk_budget: float
+    compilation_database: str
+    entry_points: List[str]
 
 
 ANALYSIS_SETTINGS: AnalysisSettings = {
-    "timeout": {"docker_start": 30, "command_execution": 300, "server_init": 5},  # seconds  # seconds  # seconds
+    "timeout": {
+        "docker_start": 30,
+        "command_execution": 300,
+        "server_init": 5,
+        "job": 3600,
+        "parse_file": 60,
+        "parse_startup": 60,
+        "analysis_reserve": 600,
+    },  # seconds
     "output": {"functions_file": "functions.json", "call_graph_file": "call_graph.json"},
+    "reachability": {"interval_labels": 2, "seed": 0},
+    "profiling": {"enabled": False, "jfr_settings": "profile"},
+    "resource_sampling_interval": 1.0,
+    "parse_report": False,
+    "mode": "full",
+    "isolation_chunk_files": 16,
+    "isolation_chunk_budget": 0.25,
+    "compilation_database": "compile_commands.json",
+    "entry_points": ["main"],
+}
+
+
+# Analysis modes: the full analysis, or an index of function signatures and call edges
+# without function bodies for first-pass triage
+ANALYSIS_MODES = ["full", "signatures"]
+
+
+class TracingSettings(TypedDict):
+    """Tracing settings.
+
+    Attributes:
+        exporter: "file" to append OTLP/JSON traces to the trace file, "otlp_http" to
+            post them to an OTLP/HTTP collector, or "none" to disable exporting; the
+            trace file is never rotated, so exporting is disabled by default
+        file: Trace file, relative to the working directory
+        endpoint: Traces endpoint of the OTLP/HTTP collector
+        service_name: Service name reported with the traces
+    """
+
+    exporter: str
+    file: str
+    endpoint: str
+    service_name: str
+
+
+TRACING_SETTINGS: TracingSettings = {
+    "exporter": "none",
+    "file": "results/traces.jsonl",
+    "endpoint": "http://localhost:4318/v1/traces",
+    "service_name": "joern-analyzer",
 }
 
 # System functions that should be recognized
@@ -278,14 +483,27 @@ class ContainerPaths(TypedDict):
         app: Path to the application code in container
         results: Path to the results directory in container
         scripts: Path to the analysis scripts in container
+        scratch: Path to the tmpfs scratch space in container
+        batch_code: Path to the common root of the code analyzed in batch mode
+        batch_results: Path to the results root in batch mode
     """
 
     app: str
     results: str
     scripts: str
-
-
-CONTAINER_PATHS: ContainerPaths = {"app": "/app", "results": "/results", "scripts": "/joern_scripts"}
+    scratch: str
+    batch_code: str
+    batch_results: str
+
+
+CONTAINER_PATHS: ContainerPaths = {
+    "app": "/app",
+    "results": "/results",
+    "scripts": "/joern_scripts",
+    "scratch": "/scratch",
+    "batch_code": "/batch/code",
+    "batch_results": "/batch/results",
+}
 
 # Project paths
 PATHS = {
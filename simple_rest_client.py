@@ -11,6 +11,12 @@ uploading them to the API, and processing the returned analysis data.
 The API is expected to be running at http://localhost:3003 and provides endpoints
 for code upload and analysis retrieval.
 
+The module also provides a load-test mode that stresses the API with concurrent
+virtual clients issuing a weighted mix of uploads and analysis requests, either in
+a closed loop (each client waits for its response) or in an open loop (requests
+arrive at a fixed average rate regardless of the responses), and reports latency
+percentiles, throughput and error rates.
+
 Example:
     ```python
     # Check if API is running
@@ -22,16 +28,33 @@ Example:
             results = get_analysis_results(code_id)
             display_results(results)
     ```
+
+Load test:
+    ```bash
+    # 8 clients, 1 upload per 4 analysis requests, for 60 seconds
+    ./simple_rest_client.py --load-test --clients 8 --mix upload:1,fetch:4 --duration 60
+
+    # Open loop with 2 requests per second on average
+    ./simple_rest_client.py --load-test --arrival open --rate 2 --duration 60
+    ```
 """
 
+import math
+import random
 import shutil
+import threading
+import time
 import zipfile
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
-from typing import Any, Dict
+from typing import Any, Dict, List, NamedTuple, Optional
 
+import click
 import requests
 from loguru import logger
 
+from utils.file_handler import FileHandler
+
 # API configuration
 API_BASE_URL = "http://localhost:3003"
 
@@ -150,6 +173,34 @@ def get_analysis_results(code_id: str) -> Dict[str, Any]:
         return {}
 
 
+def upload_and_analyze(zip_path: Path) -> Dict[str, Any]:
+    """Upload code and get its analysis results in one request.
+
+    The API starts the analysis while it extracts the zip file, so this is faster
+    than upload_code() followed by get_analysis_results().
+
+    Args:
+        zip_path (Path): Path to the zip file containing the code to analyze.
+
+    Returns:
+        Dict[str, Any]: The results as returned by get_analysis_results(), plus the
+            code_id, or an empty dictionary if the request failed.
+    """
+    try:
+        with open(zip_path, "rb") as f:
+            response = requests.post(f"{API_BASE_URL}/analyze", files={"file": f})
+
+        if response.status_code == 200:
+            return response.json()
+        else:
+            logger.error(f"Upload and analysis failed: {response.text}")
+            return {}
+
+    except Exception as e:
+        logger.error(f"Error uploading and analyzing code: {str(e)}")
+        return {}
+
+
 def display_results(results: Dict[str, Any]) -> None:
     """Display analysis results in a readable format.
 
@@ -214,10 +265,259 @@ def is_api_running() -> bool:
         return False
 
 
-def main() -> None:
-    """Main function to demonstrate API usage.
+class LoadTestResult(NamedTuple):
+    """Outcome of a single load test request."""
+
+    operation: str
+    latency: float
+    ok: bool
+
+
+def percentile(values: List[float], fraction: float) -> float:
+    """Get a percentile of values with the nearest-rank method.
 
-    This function demonstrates the complete workflow of:
+    Args:
+        values (List[float]): Sorted values, must not be empty
+        fraction (float): Percentile as a fraction, e.g. 0.95
+
+    Returns:
+        float: The percentile
+    """
+    rank = max(1, math.ceil(fraction * len(values)))
+    return values[min(rank, len(values)) - 1]
+
+
+def parse_mix(mix: str) -> Dict[str, float]:
+    """Parse an operation mix like "upload:1,fetch:4" into normalized weights.
+
+    Args:
+        mix (str): Comma separated operation:weight pairs, operations are upload and fetch
+
+    Returns:
+        Dict[str, float]: Probability of each operation
+
+    Raises:
+        ValueError: If the mix is malformed or has no positive weight
+    """
+    weights: Dict[str, float] = {}
+    for part in mix.split(","):
+        operation, _, weight = part.partition(":")
+        if operation.strip() not in ("upload", "fetch"):
+            raise ValueError(f"Unknown operation in mix: {operation}")
+        weights[operation.strip()] = float(weight or 1)
+    total = sum(weights.values())
+    if total <= 0 or any(weight < 0 for weight in weights.values()):
+        raise ValueError(f"Mix needs non-negative weights with a positive sum: {mix}")
+    return {operation: weight / total for operation, weight in weights.items()}
+
+
+class LoadTest:
+    """Concurrent load test of the API.
+
+    Every virtual client uses its own HTTP session. Uploads post the zipped test code,
+    fetches request the analysis of code uploaded before the test.
+
+    Attributes:
+        api_url (str): Base URL of the API
+        zip_data (bytes): Zipped code used for uploads
+        code_id (str): ID of the uploaded code used for fetches
+        mix (Dict[str, float]): Probability of each operation
+        timeout (float): Timeout of each request in seconds
+    """
+
+    def __init__(self, api_url: str, zip_data: bytes, code_id: str, mix: Dict[str, float], timeout: float):
+        """Initialize the load test.
+
+        Args:
+            api_url (str): Base URL of the API
+            zip_data (bytes): Zipped code used for uploads
+            code_id (str): ID of the uploaded code used for fetches
+            mix (Dict[str, float]): Probability of each operation
+            timeout (float): Timeout of each request in seconds
+        """
+        self.api_url = api_url
+        self.zip_data = zip_data
+        self.code_id = code_id
+        self.mix = mix
+        self.timeout = timeout
+        self._local = threading.local()
+
+    def _session(self) -> requests.Session:
+        """Get the HTTP session of the calling client thread."""
+        if not hasattr(self._local, "session"):
+            self._local.session = requests.Session()
+        return self._local.session
+
+    def _choose_operation(self, rng: random.Random) -> str:
+        """Choose an operation according to the mix."""
+        return rng.choices(list(self.mix), weights=list(self.mix.values()))[0]
+
+    def request(self, operation: str, scheduled: Optional[float] = None) -> LoadTestResult:
+        """Issue one request.
+
+        Args:
+            operation (str): "upload" or "fetch"
+            scheduled (Optional[float]): Scheduled start (time.perf_counter()) in open
+                loop tests; the latency includes the time the request waited for a
+                free client, so that queueing in the client is not hidden
+
+        Returns:
+            LoadTestResult: The operation, its latency and whether it succeeded
+        """
+        start = time.perf_counter() if scheduled is None else scheduled
+        try:
+            if operation == "upload":
+                response = self._session().post(
+                    f"{self.api_url}/upload_code", files={"file": ("code.zip", self.zip_data)}, timeout=self.timeout
+                )
+            else:
+                response = self._session().get(f"{self.api_url}/call_graph/{self.code_id}", timeout=self.timeout)
+            ok = response.status_code == 200
+        except requests.RequestException as e:
+            logger.debug(f"Load test request failed: {str(e)}")
+            ok = False
+        return LoadTestResult(operation, time.perf_counter() - start, ok)
+
+    def run_closed_loop(self, clients: int, duration: float, seed: int) -> List[LoadTestResult]:
+        """Run a closed loop test, each client issuing its next request when the previous one completes.
+
+        Args:
+            clients (int): Number of concurrent clients
+            duration (float): Seconds after which no new requests are started
+            seed (int): Seed for choosing operations
+
+        Returns:
+            List[LoadTestResult]: Results of all requests
+        """
+        deadline = time.perf_counter() + duration
+
+        def client(index: int) -> List[LoadTestResult]:
+            rng = random.Random(seed + index)
+            results = []
+            while time.perf_counter() < deadline:
+                results.append(self.request(self._choose_operation(rng)))
+            return results
+
+        with ThreadPoolExecutor(max_workers=clients) as executor:
+            return [result for results in executor.map(client, range(clients)) for result in results]
+
+    def run_open_loop(self, clients: int, duration: float, rate: float, seed: int) -> List[LoadTestResult]:
+        """Run an open loop test with Poisson arrivals at a fixed average rate.
+
+        Requests arrive independently of the responses and are served by the clients;
+        when all clients are busy, arrivals queue up and their wait counts as latency.
+
+        Args:
+            clients (int): Number of concurrent clients
+            duration (float): Seconds during which requests arrive
+            rate (float): Average number of arrivals per second
+            seed (int): Seed for the arrival times and operations
+
+        Returns:
+            List[LoadTestResult]: Results of all requests
+        """
+        rng = random.Random(seed)
+        start = time.perf_counter()
+        futures = []
+        with ThreadPoolExecutor(max_workers=clients) as executor:
+            scheduled = start + rng.expovariate(rate)
+            while scheduled < start + duration:
+                time.sleep(max(0.0, scheduled - time.perf_counter()))
+                futures.append(executor.submit(self.request, self._choose_operation(rng), scheduled))
+                scheduled += rng.expovariate(rate)
+        return [future.result() for future in futures]
+
+
+def load_test_report(results: List[LoadTestResult], elapsed: float) -> Dict[str, Dict[str, Any]]:
+    """Summarize the results of a load test.
+
+    Args:
+        results (List[LoadTestResult]): Results of all requests
+        elapsed (float): Wall time of the test in seconds
+
+    Returns:
+        Dict[str, Dict[str, Any]]: For each operation and "total": number of requests,
+            errors, error rate, throughput (successful requests per second) and latency
+            percentiles p50, p95, p99 and max in seconds
+    """
+    report: Dict[str, Dict[str, Any]] = {}
+    operations = sorted({result.operation for result in results})
+    for operation in operations + ["total"]:
+        selected = [result for result in results if operation in ("total", result.operation)]
+        latencies = sorted(result.latency for result in selected)
+        errors = sum(not result.ok for result in selected)
+        report[operation] = {
+            "requests": len(selected),
+            "errors": errors,
+            "error_rate": errors / len(selected) if selected else 0.0,
+            "throughput": (len(selected) - errors) / elapsed if elapsed > 0 else 0.0,
+            **{
+                name: percentile(latencies, fraction) if latencies else None
+                for name, fraction in (("p50", 0.50), ("p95", 0.95), ("p99", 0.99), ("max", 1.0))
+            },
+        }
+    return report
+
+
+def display_load_test_report(report: Dict[str, Dict[str, Any]]) -> None:
+    """Display a load test report as a table.
+
+    Args:
+        report (Dict[str, Dict[str, Any]]): Report from load_test_report()
+    """
+    logger.info("\n=== Load Test ===")
+    logger.info(
+        f"{'operation':<10} {'requests':>9} {'errors':>7} {'error %':>8} {'req/s':>8}"
+        f" {'p50 [s]':>8} {'p95 [s]':>8} {'p99 [s]':>8} {'max [s]':>8}"
+    )
+    for operation, stats in report.items():
+        latencies = " ".join(
+            f"{stats[name]:>8.3f}" if stats[name] is not None else f"{'-':>8}" for name in ("p50", "p95", "p99", "max")
+        )
+        logger.info(
+            f"{operation:<10} {stats['requests']:>9} {stats['errors']:>7} {stats['error_rate']:>8.1%}"
+            f" {stats['throughput']:>8.2f} {latencies}"
+        )
+
+
+@click.command()
+@click.option(
+    "--code",
+    "code_dir",
+    type=click.Path(exists=True, file_okay=False, dir_okay=True, path_type=Path),
+    default=None,
+    help="Code to upload [default: test_code/more_complex]",
+)
+@click.option("--load-test", is_flag=True, default=False, help="Stress the API with concurrent clients")
+@click.option("--clients", default=4, show_default=True, help="Number of concurrent clients")
+@click.option("--duration", default=30.0, show_default=True, help="Load test duration in seconds")
+@click.option("--mix", default="upload:1,fetch:4", show_default=True, help="Weights of upload and fetch requests")
+@click.option("--arrival", type=click.Choice(["closed", "open"]), default="closed", show_default=True)
+@click.option("--rate", default=1.0, show_default=True, help="Average requests per second of open loop tests")
+@click.option("--timeout", default=600.0, show_default=True, help="Timeout of each request in seconds")
+@click.option("--seed", default=0, show_default=True, help="Random seed for operations and arrivals")
+@click.option(
+    "--report",
+    "report_file",
+    type=click.Path(dir_okay=False, path_type=Path),
+    default=None,
+    help="Save the load test report as JSON",
+)
+def main(
+    code_dir: Optional[Path],
+    load_test: bool,
+    clients: int,
+    duration: float,
+    mix: str,
+    arrival: str,
+    rate: float,
+    timeout: float,
+    seed: int,
+    report_file: Optional[Path],
+) -> None:
+    """Upload code, analyze it and display the results, or load test the API.
+
+    Without --load-test, this demonstrates the complete workflow of:
     1. Checking API availability
     2. Creating a zip file from test code
     3. Uploading the code for analysis
@@ -225,12 +525,6 @@ def main() -> None:
 
     The function uses a temporary directory for the zip file and cleans up
     after execution.
-
-    Example:
-        ```python
-        if __name__ == '__main__':
-            main()
-        ```
     """
     # Check if API is running first
     if not is_api_running():
@@ -243,7 +537,7 @@ def main() -> None:
 
     try:
         # Path to the test code
-        test_code_dir = Path.cwd() / "test_code" / "more_complex"
+        test_code_dir = code_dir or Path.cwd() / "test_code" / "more_complex"
         if not test_code_dir.exists():
             logger.error(f"Test code directory not found: {test_code_dir}")
             return
@@ -258,6 +552,25 @@ def main() -> None:
         if not code_id:
             return
 
+        if load_test:
+            try:
+                weights = parse_mix(mix)
+            except ValueError as e:
+                raise click.BadParameter(str(e), param_hint="--mix") from None
+
+            tester = LoadTest(API_BASE_URL, zip_path.read_bytes(), code_id, weights, timeout)
+            logger.info(f"Load testing with {clients} clients ({arrival} loop) for {duration:.0f}s...")
+            start = time.perf_counter()
+            if arrival == "open":
+                results_list = tester.run_open_loop(clients, duration, rate, seed)
+            else:
+                results_list = tester.run_closed_loop(clients, duration, seed)
+            report = load_test_report(results_list, time.perf_counter() - start)
+            display_load_test_report(report)
+            if report_file:
+                FileHandler.write_json(report, report_file)
+            return
+
         # Get and display results
         results = get_analysis_results(code_id)
         display_results(results)
@@ -0,0 +1,41 @@
+"""Shared fixtures of the tests.
+
+The analyses run on the offline backend (see utils/offline_docker_manager.py), so the
+tests need neither Docker nor the Joern image.
+"""
+
+from pathlib import Path
+
+import pytest
+
+from generate_test_code import GeneratorParameters, generate_codebase
+from utils.tracing import TRACER
+
+
+@pytest.fixture(autouse=True)
+def trace_file(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> Path:
+    """Export the traces of the test to a temporary file instead of results/traces.jsonl."""
+    path = tmp_path / "traces.jsonl"
+    monkeypatch.setattr(TRACER, "file", path)
+    return path
+
+
+@pytest.fixture
+def test_code() -> Path:
+    """The example projects, with the recorded Joern output the offline backend replays."""
+    return Path(__file__).resolve().parent.parent / "test_code"
+
+
+@pytest.fixture
+def workdir(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> Path:
+    """Run the test in a temporary working directory, where ./results is written."""
+    monkeypatch.chdir(tmp_path)
+    return tmp_path
+
+
+@pytest.fixture
+def generated_code(tmp_path: Path) -> Path:
+    """A small generated codebase, whose Joern output the offline backend synthesizes."""
+    code_path = tmp_path / "generated"
+    generate_codebase(code_path, GeneratorParameters(files=8, functions_per_file=3, seed=1))
+    return code_path
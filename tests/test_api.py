@@ -0,0 +1,318 @@
+"""Tests of the REST API in api.py on the recorded results of test_code/simple."""
+
+import importlib
+import io
+import json
+import threading
+import zipfile
+from pathlib import Path
+from types import ModuleType
+from typing import Any, Dict, List
+
+import pytest
+from flask.testing import FlaskClient
+
+from results_processor import ResultsProcessor
+
+# Code IDs are SHA-512 hashes
+CODE_ID = "0" * 128
+
+
+@pytest.fixture
+def api(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> ModuleType:
+    """The API module, with the code and results directories in a temporary directory."""
+    monkeypatch.chdir(tmp_path)
+    module = importlib.import_module("api")
+    monkeypatch.setattr(module, "CODE_DIR", tmp_path / "code")
+    monkeypatch.setattr(module, "RESULTS_DIR", tmp_path / "results")
+    (tmp_path / "code").mkdir(exist_ok=True)
+    (tmp_path / "results").mkdir(exist_ok=True)
+    return module
+
+
+def _recorded() -> Any:
+    return json.loads((Path(__file__).resolve().parent.parent / "test_code/simple_results.json").read_text())
+
+
+def _analyze(api: ModuleType, code_id: str, functions: List[Dict[str, Any]], call_graph: List[Dict[str, Any]]) -> None:
+    results_path = api.RESULTS_DIR / code_id
+    results_path.mkdir()
+    ResultsProcessor(results_path).get_all_results(functions, call_graph)
+
+
+@pytest.fixture
+def client(api: ModuleType) -> FlaskClient:
+    """A test client of the API, with CODE_ID analyzed."""
+    recorded = _recorded()
+    _analyze(api, CODE_ID, recorded["functions"], recorded["call_graph"])
+    return api.app.test_client()
+
+
+def test_reachability(client: FlaskClient) -> None:
+    response = client.post(f"/reachability/{CODE_ID}", json={"sources": ["main", "missing"], "targets": ["add"]})
+
+    assert response.status_code == 200
+    assert response.get_json() == {"reachable": {"main": ["add"]}, "unknown": ["missing"]}
+
+
+def test_reachability_of_unknown_code(client: FlaskClient) -> None:
+    response = client.post(f"/reachability/{'1' * 128}", json={"sources": ["main"]})
+
+    assert response.status_code == 404
+
+
+def test_reachability_requires_a_sources_list(client: FlaskClient) -> None:
+    response = client.post(f"/reachability/{CODE_ID}", json={"sources": "main"})
+
+    assert response.status_code == 400
+
+
+@pytest.mark.parametrize("body", [{"sources": [["main"]]}, {"sources": ["main"], "targets": [1]}])
+def test_reachability_requires_function_names(client: FlaskClient, body: Any) -> None:
+    response = client.post(f"/reachability/{CODE_ID}", json=body)
+
+    assert response.status_code == 400
+
+
+def test_components(client: FlaskClient) -> None:
+    response = client.get(f"/components/{CODE_ID}")
+
+    assert response.status_code == 200
+    components = response.get_json()
+    assert components["recursive"] == []
+    assert len(components["dag"]["offsets"]) == len(components["components"]) + 1
+    assert {name for names in components["components"] for name in names} == set(components["function_components"])
+    assert "main" in components["function_components"]
+
+
+def test_components_of_unknown_code(client: FlaskClient) -> None:
+    assert client.get(f"/components/{'1' * 128}").status_code == 404
+
+
+def test_search(client: FlaskClient) -> None:
+    response = client.get("/search", query_string={"q": "ad+\\(", "regex": "true"})
+
+    assert response.status_code == 200
+    matches = response.get_json()["matches"]
+    assert list(matches) == [CODE_ID]
+    assert "add" in [match["name"] for match in matches[CODE_ID]]
+
+
+def test_search_rejects_invalid_queries(client: FlaskClient) -> None:
+    assert client.get("/search").status_code == 400
+    assert client.get("/search", query_string={"q": "(", "regex": "1"}).status_code == 400
+    assert client.get("/search", query_string={"q": "add", "limit": "many"}).status_code == 400
+    assert client.get("/search", query_string={"q": "add", "limit": "0"}).status_code == 400
+    assert client.get("/search", query_string={"q": "add", "code_id": "../" + CODE_ID}).status_code == 400
+    assert client.get("/search", query_string={"q": "add", "code_id": "1" * 128}).status_code == 404
+
+
+def test_diff(api: ModuleType, client: FlaskClient) -> None:
+    recorded = _recorded()
+    new_id = "2" * 128
+    _analyze(
+        api,
+        new_id,
+        [function for function in recorded["functions"] if function["name"] != "log_operation"],
+        [call for call in recorded["call_graph"] if "log_operation" not in (call["method"], call["name"])],
+    )
+
+    response = client.get(f"/diff/{CODE_ID}/{new_id}")
+
+    assert response.status_code == 200
+    diff = response.get_json()
+    assert [function["name"] for function in diff["functions"]["removed"]] == ["log_operation"]
+    assert diff["functions"]["added"] == diff["edges"]["added"] == []
+    assert {"log_operation"} & {edge["callee"] for edge in diff["edges"]["removed"]}
+    assert client.get(f"/diff/{CODE_ID}/{new_id}").get_json() == diff
+    assert client.get(f"/diff/{CODE_ID}/{CODE_ID}").get_json()["files"]["changed"] == 0
+
+
+def test_diff_of_unknown_code(client: FlaskClient) -> None:
+    assert client.get(f"/diff/{CODE_ID}/{'1' * 128}").status_code == 404
+
+
+def test_export(client: FlaskClient) -> None:
+    response = client.get(f"/export/{CODE_ID}/dot")
+
+    assert response.status_code == 200
+    assert response.mimetype == "text/vnd.graphviz"
+    dot = response.get_data(as_text=True)
+    assert dot.startswith("digraph call_graph {")
+    assert 'label="main", file=' in dot
+
+
+def test_export_rejects_unknown_formats(client: FlaskClient) -> None:
+    assert client.get(f"/export/{CODE_ID}/svg").status_code == 400
+    assert client.get(f"/export/{'1' * 128}/dot").status_code == 404
+
+
+def test_federation(client: FlaskClient) -> None:
+    response = client.post(f"/federation/{CODE_ID}")
+    assert response.status_code == 200
+    assert response.get_json()["exported"] > 0
+    assert client.get("/federation").get_json() == {"code_ids": [CODE_ID]}
+    assert client.get(f"/federation/{CODE_ID}/links").status_code == 200
+
+    response = client.post(
+        "/federation/reachability",
+        json={
+            "sources": [{"code_id": CODE_ID, "function": "main"}],
+            "targets": [{"code_id": CODE_ID, "function": "add"}],
+        },
+    )
+    assert response.status_code == 200
+    assert response.get_json()["reachable"] == [
+        {"source": {"code_id": CODE_ID, "function": "main"}, "targets": [{"code_id": CODE_ID, "function": "add"}]}
+    ]
+
+    assert client.delete(f"/federation/{CODE_ID}").status_code == 200
+    assert client.delete(f"/federation/{CODE_ID}").status_code == 404
+
+
+def test_federation_reachability_requires_function_refs(client: FlaskClient) -> None:
+    response = client.post("/federation/reachability", json={"sources": [CODE_ID], "targets": []})
+
+    assert response.status_code == 400
+
+
+@pytest.mark.parametrize(
+    "ref",
+    [
+        {"code_id": [CODE_ID], "function": "main"},
+        {"code_id": CODE_ID, "function": {"name": "main"}},
+        {"code_id": "../" + CODE_ID, "function": "main"},
+    ],
+)
+def test_federation_reachability_rejects_invalid_refs(client: FlaskClient, ref: Dict[str, Any]) -> None:
+    client.post(f"/federation/{CODE_ID}")
+
+    response = client.post("/federation/reachability", json={"sources": [ref], "targets": []})
+    assert response.status_code == 400
+    response = client.post("/federation/reachability", json={"sources": [], "targets": [ref]})
+    assert response.status_code == 400
+
+
+def test_federation_reachability_requires_registered_code_ids(client: FlaskClient) -> None:
+    query = {"sources": [{"code_id": CODE_ID, "function": "main"}], "targets": []}
+
+    response = client.post("/federation/reachability", json=query)
+    assert response.status_code == 404
+    assert CODE_ID in response.get_json()["error"]
+
+    client.post(f"/federation/{CODE_ID}")
+    query["targets"] = [{"code_id": "1" * 128, "function": "add"}]
+    assert client.post("/federation/reachability", json=query).status_code == 404
+
+
+def test_entry_points(client: FlaskClient) -> None:
+    response = client.get(f"/entry_points/{CODE_ID}")
+
+    assert response.status_code == 200
+    result = response.get_json()
+    names = result["names"]
+    main = result["entry_points"]["main"]
+    assert main["depth"][names.index("main")] == 0
+    assert main["depth"][names.index("add")] >= 1
+    assert main["idom"][names.index("main")] == names.index("main")
+    assert len(main["depth"]) == len(main["idom"]) == len(names)
+
+
+def test_entry_points_of_unknown_code(client: FlaskClient) -> None:
+    assert client.get(f"/entry_points/{'1' * 128}").status_code == 404
+
+
+@pytest.mark.parametrize(
+    "method, route",
+    [
+        ("get", "/call_graph/{}"),
+        ("get", "/status/{}"),
+        ("get", "/components/{}"),
+        ("get", "/entry_points/{}"),
+        ("post", "/reachability/{}"),
+        ("get", "/diff/{}/" + CODE_ID),
+        ("get", "/diff/" + CODE_ID + "/{}"),
+        ("get", "/export/{}/dot"),
+        ("post", "/federation/{}"),
+        ("delete", "/federation/{}"),
+        ("get", "/federation/{}/links"),
+        ("get", "/search?q=add&code_id={}"),
+    ],
+)
+@pytest.mark.parametrize("code_id", ["..", "0" * 127, "0" * 127 + "g", "A" * 128])
+def test_rejects_invalid_code_ids(client: FlaskClient, method: str, route: str, code_id: str) -> None:
+    response = getattr(client, method)(route.format(code_id), json={"sources": ["main"]})
+
+    assert response.status_code == 400
+    assert response.get_json() == {"error": "Invalid code ID"}
+
+
+def test_metrics(client: FlaskClient) -> None:
+    response = client.get("/metrics")
+
+    assert response.status_code == 200
+    assert response.mimetype == "text/plain"
+    assert "# TYPE joern_analyzer_phase_duration_seconds histogram" in response.get_data(as_text=True)
+
+
+def _zip_directory(directory: Path) -> io.BytesIO:
+    data = io.BytesIO()
+    with zipfile.ZipFile(data, "w") as archive:
+        for path in sorted(directory.rglob("*")):
+            if path.is_file():
+                archive.write(path, path.relative_to(directory).as_posix())
+    data.seek(0)
+    return data
+
+
+def test_upload_and_analyze(api: ModuleType, generated_code: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setitem(api.app.config, "BACKEND", "offline")
+    client = api.app.test_client()
+
+    response = client.post("/analyze", data={"file": (_zip_directory(generated_code), "code.zip")})
+
+    assert response.status_code == 200
+    result = response.get_json()
+    assert result["functions"]
+    assert (api.CODE_DIR / result["code_id"] / "main.c").exists()
+    assert not list(api.CODE_DIR.glob("temp_*.zip"))
+
+    response = client.post("/analyze", data={"file": (_zip_directory(generated_code), "code.zip")})
+    assert response.status_code == 200
+    assert response.get_json()["code_id"] == result["code_id"]
+
+
+def test_upload_and_analyze_rejects_invalid_zip_files(api: ModuleType) -> None:
+    client = api.app.test_client()
+
+    response = client.post("/analyze", data={"file": (io.BytesIO(b"not a zip file"), "code.zip")})
+
+    assert response.status_code == 400
+    assert not list(api.CODE_DIR.iterdir())
+
+
+def test_uploads_of_the_same_code_share_the_running_extraction(
+    api: ModuleType, generated_code: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    extracting, proceed = threading.Event(), threading.Event()
+    extractall = zipfile.ZipFile.extractall
+
+    def blocking(self: zipfile.ZipFile, *args: Any, **kwargs: Any) -> None:
+        extracting.set()
+        proceed.wait(5)
+        extractall(self, *args, **kwargs)
+
+    monkeypatch.setattr(zipfile.ZipFile, "extractall", blocking)
+    for name in ("first.zip", "second.zip"):
+        (api.CODE_DIR / name).write_bytes(_zip_directory(generated_code).getvalue())
+
+    extraction = api.extract_upload(CODE_ID, api.CODE_DIR / "first.zip")
+    assert extracting.wait(5)
+    assert api.extract_upload(CODE_ID, api.CODE_DIR / "second.zip") is extraction
+    assert not (api.CODE_DIR / "second.zip").exists()
+    assert not (api.CODE_DIR / CODE_ID).exists()
+
+    proceed.set()
+    extraction.wait()
+    assert api.EXTRACTIONS == {}
+    assert (api.CODE_DIR / CODE_ID / "main.c").exists()
@@ -0,0 +1,50 @@
+"""Tests of the benchmark aggregation and regression checks in benchmark.py."""
+
+from typing import Any, Dict
+
+import click
+import pytest
+
+from benchmark import _parse_generated, aggregate, find_regressions
+from generate_test_code import GeneratorParameters
+
+
+def test_aggregate() -> None:
+    runs = [
+        {"wall_seconds": 3.0, "phases": {"cpg": 2.0}, "python_peak_rss_bytes": 10, "output_bytes": 1},
+        {"wall_seconds": 1.0, "phases": {"cpg": 1.0, "query": 0.5}, "python_peak_rss_bytes": 30, "output_bytes": 2},
+        {"wall_seconds": 2.0, "phases": {"cpg": 4.0}, "python_peak_rss_bytes": None, "output_bytes": 3},
+    ]
+
+    assert aggregate(runs) == {
+        "wall_seconds": 2.0,
+        "wall_seconds_runs": [3.0, 1.0, 2.0],
+        "phases": {"cpg": 2.0, "query": 0.0},
+        "python_peak_rss_bytes": 30,
+        "container_memory_peak_bytes": None,
+        "output_bytes": 3,
+    }
+
+
+def test_find_regressions() -> None:
+    baseline: Dict[str, Dict[str, Any]] = {
+        "simple": {"wall_seconds": 10.0, "phases": {"cpg": 0.1, "query": 5.0}, "output_bytes": 100},
+        "removed": {"wall_seconds": 1.0},
+    }
+    current: Dict[str, Dict[str, Any]] = {
+        "simple": {"wall_seconds": 11.0, "phases": {"cpg": 0.15, "query": 7.0}, "output_bytes": 200},
+        "added": {"wall_seconds": 100.0},
+    }
+
+    assert find_regressions(current, baseline, 0.2) == [
+        ("simple", "phase:query", 5.0, 7.0),
+        ("simple", "output_bytes", 100, 200),
+    ]
+    assert find_regressions(current, baseline, 1.5) == []
+
+
+def test_parse_generated() -> None:
+    assert _parse_generated("100x10") == GeneratorParameters(files=100, functions_per_file=10)
+    assert _parse_generated("2x3_s7") == GeneratorParameters(files=2, functions_per_file=3, seed=7)
+    with pytest.raises(click.BadParameter):
+        _parse_generated("100")
@@ -0,0 +1,125 @@
+"""Tests of the call graph algorithms in utils/call_graph.py."""
+
+import random
+from typing import Dict, List, Set, Tuple
+
+from utils.call_graph import CallGraph
+
+
+def _graph(edges: List[Tuple[str, str]], functions: Tuple[str, ...] = ()) -> CallGraph:
+    return CallGraph.from_calls([{"method": caller, "name": callee} for caller, callee in edges], functions)
+
+
+def _reachable(edges: Dict[int, Set[int]], root: int) -> Set[int]:
+    seen, stack = {root}, [root]
+    while stack:
+        for callee in edges.get(stack.pop(), ()):
+            if callee not in seen:
+                seen.add(callee)
+                stack.append(callee)
+    return seen
+
+
+def _random_edges(rng: random.Random, num_nodes: int, num_edges: int) -> List[Tuple[int, int]]:
+    return [(rng.randrange(num_nodes), rng.randrange(num_nodes)) for _ in range(num_edges)]
+
+
+def _adjacency(pairs: List[Tuple[int, int]]) -> Dict[int, Set[int]]:
+    edges: Dict[int, Set[int]] = {}
+    for caller, callee in pairs:
+        edges.setdefault(caller, set()).add(callee)
+    return edges
+
+
+def test_strongly_connected_components_in_reverse_topological_order() -> None:
+    graph = _graph([("main", "a"), ("a", "b"), ("b", "a"), ("b", "c"), ("c", "c"), ("main", "d")])
+    comp = graph.strongly_connected_components()
+
+    ids = graph.ids
+    assert comp[ids["a"]] == comp[ids["b"]]
+    assert len({comp[ids[name]] for name in ("main", "a", "c", "d")}) == 4
+    for node in range(graph.num_nodes):
+        for callee in graph.successors(node):
+            assert comp[node] >= comp[callee]
+    assert graph.recursive_nodes(comp) == sorted([ids["a"], ids["b"], ids["c"]])
+
+
+def test_strongly_connected_components_match_mutual_reachability() -> None:
+    rng = random.Random(7)
+    for _ in range(20):
+        num_nodes = rng.randint(1, 30)
+        pairs = _random_edges(rng, num_nodes, rng.randint(0, 60))
+        graph = CallGraph.from_edges([str(node) for node in range(num_nodes)], pairs)
+        edges = _adjacency(pairs)
+        reach = [_reachable(edges, node) for node in range(num_nodes)]
+        comp = graph.strongly_connected_components()
+
+        for first in range(num_nodes):
+            for second in range(num_nodes):
+                mutual = second in reach[first] and first in reach[second]
+                assert (comp[first] == comp[second]) == mutual
+
+
+def test_condense() -> None:
+    graph = _graph([("main", "a"), ("a", "b"), ("b", "a"), ("b", "c"), ("main", "c")])
+    comp = graph.strongly_connected_components()
+    dag = graph.condense(comp)
+
+    ids = graph.ids
+    assert dag.num_nodes == 3
+    assert dag.has_edge(comp[ids["main"]], comp[ids["a"]])
+    assert dag.has_edge(comp[ids["a"]], comp[ids["c"]])
+    assert dag.has_edge(comp[ids["main"]], comp[ids["c"]])
+    assert dag.num_edges == 3
+
+
+def test_call_depths() -> None:
+    graph = _graph([("main", "a"), ("a", "b"), ("main", "b"), ("b", "c"), ("c", "a")], functions=("unreachable",))
+    ids = graph.ids
+    depth = graph.call_depths([ids["main"]])
+
+    assert [depth[ids[name]] for name in ("main", "a", "b", "c", "unreachable")] == [0, 1, 1, 2, -1]
+    assert graph.call_depths([ids["a"], ids["c"]])[ids["b"]] == 1
+
+
+def test_dominators() -> None:
+    # main -> a -> c, main -> b -> c, c -> d: only main dominates c, and c dominates d
+    graph = _graph([("main", "a"), ("main", "b"), ("a", "c"), ("b", "c"), ("c", "d")], functions=("unreachable",))
+    ids = graph.ids
+    idom = graph.dominators(ids["main"])
+
+    assert idom[ids["main"]] == ids["main"]
+    assert idom[ids["a"]] == ids["main"]
+    assert idom[ids["b"]] == ids["main"]
+    assert idom[ids["c"]] == ids["main"]
+    assert idom[ids["d"]] == ids["c"]
+    assert idom[ids["unreachable"]] == -1
+
+
+def test_dominators_match_definition() -> None:
+    # d dominates v iff v is unreachable from the root once d is removed
+    rng = random.Random(3)
+    for _ in range(20):
+        num_nodes = rng.randint(2, 20)
+        pairs = [(rng.randrange(num_nodes), rng.randrange(num_nodes)) for _ in range(rng.randint(1, 40))]
+        graph = CallGraph.from_edges([str(node) for node in range(num_nodes)], pairs)
+        edges: Dict[int, Set[int]] = {}
+        for caller, callee in pairs:
+            edges.setdefault(caller, set()).add(callee)
+        reachable = _reachable(edges, 0)
+        idom = graph.dominators(0, graph.reverse())
+
+        for node in range(num_nodes):
+            if node not in reachable:
+                assert idom[node] == -1
+                continue
+            dominators = {0, node}
+            for candidate in reachable - {0, node}:
+                without = {caller: callees - {candidate} for caller, callees in edges.items() if caller != candidate}
+                if node not in _reachable(without, 0):
+                    dominators.add(candidate)
+            # The immediate dominator is the dominator closest to the node
+            chain = [node]
+            while chain[-1] != 0:
+                chain.append(idom[chain[-1]])
+            assert set(chain) == dominators
@@ -0,0 +1,82 @@
+"""Tests of the compilation database mapping in utils/compilation_database.py."""
+
+from pathlib import Path
+from typing import Any, Dict, List
+
+from utils.compilation_database import prepare_compilation_database
+
+
+def _code(tmp_path: Path) -> Path:
+    code_path = tmp_path / "code"
+    for file in ["src/a.c", "src/b.c", "include/a.h"]:
+        (code_path / file).parent.mkdir(parents=True, exist_ok=True)
+        (code_path / file).write_text("")
+    return code_path
+
+
+def test_maps_paths_into_the_container(tmp_path: Path) -> None:
+    database: List[Dict[str, Any]] = [
+        {
+            "directory": "/home/dev/project/build",
+            "file": "../src/a.c",
+            "arguments": ["gcc", "-I../include", "-isystem", "/usr/include", "-DNDEBUG", "-O2", "-c", "../src/a.c"],
+        },
+        {"directory": "/home/dev/project", "file": "src/b.c", "command": "cc -std=c11 -Iinclude -c src/b.c"},
+    ]
+    entries, stats = prepare_compilation_database(_code(tmp_path), database, "/batch/code/x")
+
+    assert entries == [
+        {
+            "directory": "/batch/code/x",
+            "file": "/batch/code/x/src/a.c",
+            "arguments": ["cc", "-I/batch/code/x/include", "-DNDEBUG", "-c", "/batch/code/x/src/a.c"],
+        },
+        {
+            "directory": "/batch/code/x",
+            "file": "/batch/code/x/src/b.c",
+            "arguments": ["cc", "-I/batch/code/x/include", "-std=c11", "-c", "/batch/code/x/src/b.c"],
+        },
+    ]
+    assert stats == {"entries": 2, "translation_units": 2, "duplicates": 0, "missing": 0, "flag_sets": 2}
+
+
+def test_keeps_the_last_definition_of_each_macro(tmp_path: Path) -> None:
+    database = [
+        {
+            "directory": "/src",
+            "file": "src/a.c",
+            "arguments": ["cc", "-DA=1", "-UB", "-std=c99", "-D", "A=2", "-DB", "-DC", "-UC", "-std=gnu11", "src/a.c"],
+        },
+        {
+            "directory": "/src",
+            "file": "src/b.c",
+            "arguments": ["cc", "-DC", "-DB", "-DA=1", "-DA=2", "-UC", "-std=gnu11"],
+        },
+    ]
+    entries, stats = prepare_compilation_database(_code(tmp_path), database, "/app")
+
+    assert entries[0]["arguments"] == ["cc", "-DA=2", "-DB", "-UC", "-std=gnu11", "-c", "/app/src/a.c"]
+    assert entries[1]["arguments"] == entries[0]["arguments"][:-1] + ["/app/src/b.c"]
+    assert stats["flag_sets"] == 1
+
+
+def test_drops_missing_and_duplicate_units(tmp_path: Path) -> None:
+    database: List[Any] = [
+        {"directory": "/src", "file": "src/a.c", "arguments": ["cc", "-DFIRST", "src/a.c"]},
+        {"directory": "/src", "file": "src/a.c", "arguments": ["cc", "-DSECOND", "src/a.c"]},
+        {"directory": "/src", "file": "src/generated.c", "arguments": ["cc", "src/generated.c"]},
+        {"directory": "/elsewhere", "file": "/elsewhere/other.c", "arguments": ["cc", "other.c"]},
+        "not an entry",
+    ]
+    entries, stats = prepare_compilation_database(_code(tmp_path), database, "/app")
+
+    assert [entry["arguments"] for entry in entries] == [["cc", "-DFIRST", "-c", "/app/src/a.c"]]
+    assert stats == {"entries": 5, "translation_units": 1, "duplicates": 1, "missing": 2, "flag_sets": 1}
+
+
+def test_no_unit_of_the_code(tmp_path: Path) -> None:
+    database = [{"directory": "/other", "file": "main.c", "arguments": ["cc", "main.c"]}]
+    entries, stats = prepare_compilation_database(_code(tmp_path), database, "/app")
+
+    assert entries == []
+    assert stats["missing"] == 1
@@ -0,0 +1,72 @@
+"""Tests of linking and reachability across code IDs in federated_index.py."""
+
+from pathlib import Path
+from typing import Dict, List
+
+import pytest
+
+from federated_index import FederatedIndex
+from results_processor import ResultsProcessor
+
+APP = "a" * 128
+LIB = "b" * 128
+
+
+def _analyze(results_dir: Path, code_id: str, calls: Dict[str, List[str]]) -> None:
+    """Process the results of an analysis defining the keys of calls, each calling its values."""
+    functions = [
+        {"name": name, "file": f"{name}.c", "lineNumber": 1, "signature": f"void {name}(void)", "code": "{}"}
+        for name in calls
+    ]
+    call_graph = [
+        {"method": caller, "name": callee, "file": f"{caller}.c", "lineNumber": 2}
+        for caller, callees in calls.items()
+        for callee in callees
+    ]
+    results_path = results_dir / code_id
+    results_path.mkdir()
+    ResultsProcessor(results_path).get_all_results(functions, call_graph)
+
+
+@pytest.fixture
+def federation(tmp_path: Path) -> FederatedIndex:
+    """A federated index of an application and a library calling back into it."""
+    _analyze(tmp_path, APP, {"main": ["lib_parse", "local", "printf"], "local": [], "on_token": []})
+    _analyze(tmp_path, LIB, {"lib_parse": ["lib_lex"], "lib_lex": ["on_token", "missing"]})
+    index = FederatedIndex(tmp_path)
+    index.register(APP)
+    index.register(LIB)
+    return index
+
+
+def test_register_and_unregister(federation: FederatedIndex) -> None:
+    assert federation.code_ids() == [APP, LIB]
+    assert federation.register(APP) == 3
+    assert federation.code_ids() == [APP, LIB]
+
+    assert federation.unregister(LIB)
+    assert not federation.unregister(LIB)
+    assert federation.code_ids() == [APP]
+    assert [link["definitions"] for link in federation.links(APP)] == [[]]
+
+
+def test_links(federation: FederatedIndex) -> None:
+    assert [(link["method"], link["name"], link["definitions"]) for link in federation.links(APP)] == [
+        ("main", "lib_parse", [LIB])
+    ]
+    assert [(link["method"], link["name"], link["definitions"]) for link in federation.links(LIB)] == [
+        ("lib_lex", "missing", []),
+        ("lib_lex", "on_token", [APP]),
+    ]
+
+
+def test_reachable_across_code_ids(federation: FederatedIndex) -> None:
+    targets = [(LIB, "lib_lex"), (APP, "on_token"), (APP, "local"), (LIB, "missing")]
+
+    reachable = federation.reachable([(APP, "main"), (LIB, "lib_parse"), (APP, "local")], targets)
+
+    assert reachable == {
+        (APP, "main"): [(APP, "local"), (APP, "on_token"), (LIB, "lib_lex")],
+        (LIB, "lib_parse"): [(APP, "on_token"), (LIB, "lib_lex")],
+        (APP, "local"): [(APP, "local")],
+    }
@@ -0,0 +1,33 @@
+"""Tests of the JSON file helpers in utils/file_handler.py."""
+
+import json
+from pathlib import Path
+
+import pytest
+
+from utils.file_handler import FileHandler
+
+ELEMENTS = [{"name": "main", "code": "{ return 0; }" * 20}, 12345, "a, ] string", [], {"nested": [1, [2, 3]]}, -1.5]
+
+
+@pytest.mark.parametrize("indent", [None, 2])
+@pytest.mark.parametrize("chunk_size", [1, 7, 1 << 16])
+def test_iter_json_array(tmp_path: Path, indent: int, chunk_size: int) -> None:
+    path = tmp_path / "array.json"
+    path.write_text(json.dumps(ELEMENTS, indent=indent))
+
+    assert list(FileHandler.iter_json_array(path, chunk_size)) == ELEMENTS
+
+
+def test_iter_json_array_of_nothing(tmp_path: Path) -> None:
+    (tmp_path / "empty.json").write_text(" [ ] \n")
+
+    assert list(FileHandler.iter_json_array(tmp_path / "empty.json")) == []
+
+
+@pytest.mark.parametrize("content", ['{"name": "main"}', '[{"name": "main"}, ', '[{"name": "ma'])
+def test_iter_json_array_rejects_other_files(tmp_path: Path, content: str) -> None:
+    (tmp_path / "broken.json").write_text(content)
+
+    with pytest.raises(ValueError):
+        list(FileHandler.iter_json_array(tmp_path / "broken.json", 4))
@@ -0,0 +1,54 @@
+"""Tests of the synthetic codebase generator in generate_test_code.py."""
+
+import re
+import shutil
+import subprocess
+from pathlib import Path
+from typing import Dict
+
+import pytest
+from click.testing import CliRunner
+
+from generate_test_code import GeneratorParameters, generate_codebase, main
+
+PARAMS = GeneratorParameters(files=6, functions_per_file=4, seed=5)
+
+
+def _contents(root: Path) -> Dict[str, bytes]:
+    return {path.relative_to(root).as_posix(): path.read_bytes() for path in sorted(root.rglob("*")) if path.is_file()}
+
+
+def test_output_is_deterministic(tmp_path: Path) -> None:
+    generate_codebase(tmp_path / "first", PARAMS)
+    generate_codebase(tmp_path / "second", PARAMS)
+    generate_codebase(tmp_path / "other", PARAMS._replace(seed=6))
+
+    assert _contents(tmp_path / "first") == _contents(tmp_path / "second")
+    assert _contents(tmp_path / "first") != _contents(tmp_path / "other")
+
+
+def test_manifest_counts(tmp_path: Path) -> None:
+    manifest = generate_codebase(tmp_path, PARAMS)
+    sources = [path.read_text() for path in tmp_path.rglob("*.c")]
+    definitions = [
+        line for source in sources for line in source.splitlines() if re.match(r"(unsigned|int) \w+\(", line)
+    ]
+
+    assert manifest["files"] == len(sources) == PARAMS.files + 1
+    assert manifest["functions"] == len(definitions)
+
+
+@pytest.mark.skipif(shutil.which("cc") is None, reason="No C compiler")
+def test_output_compiles(tmp_path: Path) -> None:
+    generate_codebase(tmp_path / "code", PARAMS)
+    sources = [str(path) for path in sorted((tmp_path / "code").rglob("*.c"))]
+
+    subprocess.run(["cc", "-fsyntax-only", "-Wall", "-Werror", *sources], check=True)
+
+
+@pytest.mark.parametrize("option", ["--files", "--functions-per-file"])
+def test_requires_a_positive_size(tmp_path: Path, option: str) -> None:
+    result = CliRunner().invoke(main, [option, "0", "--output", str(tmp_path / "code")])
+
+    assert result.exit_code == 2
+    assert not (tmp_path / "code").exists()
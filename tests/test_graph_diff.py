@@ -0,0 +1,53 @@
+"""Tests of the sharded call graph diff in utils/graph_diff.py."""
+
+from typing import Any, Dict, List
+
+from utils.graph_diff import diff_shards, shard_results
+
+FUNCTIONS: List[Dict[str, Any]] = [
+    {"name": "main", "file": "main.c"},
+    {"name": "parse", "file": "parse.c"},
+    {"name": "lex", "file": "parse.c"},
+]
+CALLS: List[Dict[str, Any]] = [
+    {"method": "main", "name": "parse", "file": "main.c"},
+    {"method": "main", "name": "parse", "file": "main.c"},
+    {"method": "parse", "name": "lex", "file": "parse.c"},
+    {"method": "<global>", "name": "main", "file": "main.c"},
+]
+
+
+def test_shard_results_groups_by_file_and_skips_global() -> None:
+    shards = shard_results(FUNCTIONS, CALLS)
+
+    assert shards["main.c"].functions == ["main"]
+    assert shards["main.c"].edges == [("main", "parse")]
+    assert shards["parse.c"].functions == ["lex", "parse"]
+    assert shards["parse.c"].edges == [("parse", "lex")]
+
+
+def test_diff_of_equal_analyses_is_empty() -> None:
+    diff = diff_shards(shard_results(FUNCTIONS, CALLS), shard_results(reversed(FUNCTIONS), reversed(CALLS)))
+
+    assert diff == {
+        "functions": {"added": [], "removed": []},
+        "edges": {"added": [], "removed": []},
+        "files": {"changed": 0, "unchanged": 2},
+    }
+
+
+def test_diff_reports_added_and_removed_functions_and_edges() -> None:
+    new_functions = FUNCTIONS[:2] + [{"name": "tokenize", "file": "parse.c"}, {"name": "util", "file": "util.c"}]
+    new_calls = CALLS[:2] + [{"method": "parse", "name": "tokenize", "file": "parse.c"}]
+
+    diff = diff_shards(shard_results(FUNCTIONS, CALLS), shard_results(new_functions, new_calls))
+
+    assert diff["functions"] == {
+        "added": [{"name": "tokenize", "file": "parse.c"}, {"name": "util", "file": "util.c"}],
+        "removed": [{"name": "lex", "file": "parse.c"}],
+    }
+    assert diff["edges"] == {
+        "added": [{"caller": "parse", "callee": "tokenize", "file": "parse.c"}],
+        "removed": [{"caller": "parse", "callee": "lex", "file": "parse.c"}],
+    }
+    assert diff["files"] == {"changed": 2, "unchanged": 1}
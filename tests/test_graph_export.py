@@ -0,0 +1,51 @@
+"""Tests of the call graph exporters in utils/graph_export.py."""
+
+import csv
+import io
+import xml.etree.ElementTree as ElementTree
+
+from utils.call_graph import CallGraph
+from utils.graph_export import iter_dot, iter_graphml, iter_neo4j_edges, iter_neo4j_nodes
+
+GRAPH = CallGraph.from_edges(["main", 'a<b>&"c"', "printf"], [(0, 1), (0, 2), (1, 2)])
+NODE_FILES = {"main": "main.c", 'a<b>&"c"': "a, b.c"}
+
+
+def test_dot() -> None:
+    dot = "".join(iter_dot(GRAPH, NODE_FILES))
+
+    assert dot.startswith("digraph call_graph {\n") and dot.endswith("}\n")
+    assert '  n0 [label="main", file="main.c"];\n' in dot
+    assert '  n1 [label="a<b>&\\"c\\"", file="a, b.c"];\n' in dot
+    assert '  n2 [label="printf"];\n' in dot
+    assert [line.strip() for line in dot.splitlines() if "->" in line] == ["n0 -> n1;", "n0 -> n2;", "n1 -> n2;"]
+
+
+def test_graphml_is_well_formed() -> None:
+    namespace = {"g": "http://graphml.graphdrawing.org/xmlns"}
+    root = ElementTree.fromstring("".join(iter_graphml(GRAPH, NODE_FILES)))
+
+    nodes = root.findall("g:graph/g:node", namespace)
+    assert [node.findtext("g:data[@key='name']", namespaces=namespace) for node in nodes] == GRAPH.names
+    assert nodes[1].findtext("g:data[@key='file']", namespaces=namespace) == "a, b.c"
+    assert nodes[2].find("g:data[@key='file']", namespace) is None
+    edges = [(edge.get("source"), edge.get("target")) for edge in root.findall("g:graph/g:edge", namespace)]
+    assert edges == [("n0", "n1"), ("n0", "n2"), ("n1", "n2")]
+
+
+def test_neo4j_csv() -> None:
+    nodes = list(csv.reader(io.StringIO("".join(iter_neo4j_nodes(GRAPH, NODE_FILES, {"printf"}, "x:")))))
+    edges = list(csv.reader(io.StringIO("".join(iter_neo4j_edges(GRAPH, "x:")))))
+
+    assert nodes == [
+        ["id:ID(Function)", "name", "file", "system:boolean", ":LABEL"],
+        ["x:0", "main", "main.c", "false", "Function"],
+        ["x:1", 'a<b>&"c"', "a, b.c", "false", "Function"],
+        ["x:2", "printf", "", "true", "Function"],
+    ]
+    assert edges == [
+        [":START_ID(Function)", ":END_ID(Function)", ":TYPE"],
+        ["x:0", "x:1", "CALLS"],
+        ["x:0", "x:2", "CALLS"],
+        ["x:1", "x:2", "CALLS"],
+    ]
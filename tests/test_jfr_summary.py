@@ -0,0 +1,60 @@
+"""Tests of the Java Flight Recorder summaries in utils/jfr_summary.py."""
+
+from typing import Any, Dict
+
+import pytest
+
+from utils.jfr_summary import summarize_recording
+
+
+def _stack(class_name: str, method: str) -> Dict[str, Any]:
+    return {"frames": [{"method": {"type": {"name": class_name}, "name": method}}]}
+
+
+def test_summarize_recording() -> None:
+    events = [
+        {"type": "jdk.GarbageCollection", "values": {"name": "G1New", "sumOfPauses": "PT0.01S"}},
+        {"type": "jdk.GarbageCollection", "values": {"name": "G1New", "sumOfPauses": "PT0.03S"}},
+        {"type": "jdk.GarbageCollection", "values": {"name": "G1Old", "sumOfPauses": "PT1M0.5S"}},
+        {"type": "jdk.GCHeapSummary", "values": {"heapUsed": 100}},
+        {"type": "jdk.GCHeapSummary", "values": {"heapUsed": 300}},
+        {
+            "type": "jdk.ObjectAllocationSample",
+            "values": {"objectClass": {"name": "java/lang/String"}, "weight": 10, "stackTrace": _stack("a/B", "c")},
+        },
+        {"type": "jdk.ObjectAllocationSample", "values": {"objectClass": {"name": "java/lang/String"}, "weight": 5}},
+        {
+            "type": "jdk.ObjectAllocationSample",
+            "values": {"objectClass": {"name": "java/lang/String"}, "weight": 20, "stackTrace": _stack("a/B", "c")},
+        },
+        {"type": "jdk.ExecutionSample", "values": {"stackTrace": _stack("a/B", "c")}},
+        {"type": "jdk.ExecutionSample", "values": {"stackTrace": _stack("a/B", "c")}},
+        {"type": "jdk.ExecutionSample", "values": {"stackTrace": _stack("x/Y", "z")}},
+        {"type": "jdk.ExecutionSample", "values": {"stackTrace": {"frames": []}}},
+        {"type": "jdk.Unknown", "values": {}},
+    ]
+
+    summary = summarize_recording({"recording": {"events": events}})
+
+    assert summary["gc"]["collections"] == 3
+    assert summary["gc"]["total_pause_seconds"] == pytest.approx(60.54)
+    assert summary["gc"]["max_pause_seconds"] == pytest.approx(60.5)
+    assert summary["gc"]["by_collector"]["G1New"] == {"collections": 2, "total_pause_seconds": pytest.approx(0.04)}
+    assert summary["heap"] == {"peak_used_bytes": 300}
+    assert summary["allocation_hot_spots"] == [
+        {"class": "java.lang.String", "frame": "a.B.c", "sampled_bytes": 30},
+        {"class": "java.lang.String", "frame": "<unknown>", "sampled_bytes": 5},
+    ]
+    assert summary["cpu_top_frames"] == [
+        {"frame": "a.B.c", "samples": 2, "fraction": pytest.approx(2 / 3)},
+        {"frame": "x.Y.z", "samples": 1, "fraction": pytest.approx(1 / 3)},
+    ]
+
+
+@pytest.mark.parametrize("recording", [None, [], {}, {"recording": None}, {"recording": {"events": None}}])
+def test_summarize_empty_recording(recording: Any) -> None:
+    summary = summarize_recording(recording)
+
+    assert summary["gc"]["collections"] == 0
+    assert summary["heap"] == {"peak_used_bytes": 0}
+    assert summary["allocation_hot_spots"] == summary["cpu_top_frames"] == []
@@ -0,0 +1,118 @@
+"""Tests of the job sizing and packing in utils/job_scheduler.py."""
+
+import threading
+from pathlib import Path
+from typing import List
+
+import pytest
+
+from settings import DOCKER_SETTINGS, ScratchSettings
+from utils import job_scheduler
+from utils.docker_manager import DockerManager
+from utils.job_scheduler import (
+    MIB,
+    Allocation,
+    JobResources,
+    JobScheduler,
+    _Node,
+    discover_nodes,
+    estimate_job_resources,
+    estimate_scratch_mb,
+    format_cpu_list,
+    parse_cpu_list,
+)
+
+
+def _scheduler() -> JobScheduler:
+    # Node 0 has 4 CPUs, node 1 has 2 CPUs, both with 8 GiB
+    return JobScheduler([_Node(0, range(0, 4), 8192), _Node(1, range(4, 6), 8192)])
+
+
+def test_cpu_lists() -> None:
+    assert parse_cpu_list("0-3,8,10-11\n") == [0, 1, 2, 3, 8, 10, 11]
+    assert parse_cpu_list("") == []
+    assert format_cpu_list([11, 0, 1, 2, 8, 10, 2]) == "0-2,8,10-11"
+
+
+def test_estimate_job_resources() -> None:
+    limits = DOCKER_SETTINGS["limits"]
+
+    assert estimate_job_resources(0, limits) == JobResources(limits["min_cpus"], limits["min_memory_mb"])
+    assert estimate_job_resources(3 * limits["source_bytes_per_cpu"], limits).cpus == 3
+    assert estimate_job_resources(10 * MIB, limits).memory_mb == (
+        limits["min_memory_mb"] + 10 * limits["memory_per_source_mb"]
+    )
+    assert estimate_job_resources(1 << 40, limits) == JobResources(limits["max_cpus"], limits["max_memory_mb"])
+
+
+def test_estimate_scratch_mb() -> None:
+    scratch: ScratchSettings = {"enabled": True, "min_size_mb": 1024, "max_size_mb": 4096, "size_per_source_mb": 100}
+
+    assert estimate_scratch_mb(MIB, scratch) == 1024
+    assert estimate_scratch_mb(20 * MIB, scratch) == 2000
+    assert estimate_scratch_mb(100 * MIB, scratch) == 4096
+    assert estimate_scratch_mb(20 * MIB, {**scratch, "enabled": False}) == 0
+
+
+def test_acquire_uses_the_best_fitting_node() -> None:
+    scheduler = _scheduler()
+
+    small = scheduler.acquire(JobResources(cpus=2, memory_mb=1024))
+    large = scheduler.acquire(JobResources(cpus=4, memory_mb=4096))
+
+    assert (small.node, small.cpus) == (1, [4, 5])
+    assert (large.node, large.cpus) == (0, [0, 1, 2, 3])
+
+
+def test_fit_shrinks_to_the_largest_node() -> None:
+    scheduler = _scheduler()
+
+    assert scheduler.fit(JobResources(cpus=16, memory_mb=65536)) == JobResources(cpus=4, memory_mb=8192)
+    assert scheduler.fit(JobResources(cpus=1, memory_mb=512)) == JobResources(cpus=1, memory_mb=512)
+
+
+def test_acquire_waits_for_release() -> None:
+    scheduler = _scheduler()
+    first = scheduler.acquire(JobResources(cpus=4, memory_mb=1024))
+    scheduler.acquire(JobResources(cpus=2, memory_mb=1024))
+    acquired: List[int] = []
+
+    waiting = threading.Thread(target=lambda: acquired.extend(scheduler.acquire(JobResources(3, 1024)).cpus))
+    waiting.start()
+    waiting.join(timeout=0.2)
+    assert waiting.is_alive()
+
+    scheduler.release(first)
+    waiting.join(timeout=5)
+    assert acquired == [0, 1, 2]
+    assert scheduler.nodes[0].free_cpus == {3}
+    assert scheduler.nodes[0].free_memory_mb == 8192 - 1024
+
+
+def test_discover_nodes(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    for node, cpus in ((0, "0-3"), (1, "4-7")):
+        (tmp_path / f"node{node}").mkdir()
+        (tmp_path / f"node{node}" / "cpulist").write_text(cpus)
+        (tmp_path / f"node{node}" / "meminfo").write_text(f"Node {node} MemTotal:       8388608 kB\n")
+    monkeypatch.setattr(job_scheduler, "NODE_PATH", tmp_path)
+    monkeypatch.setattr(job_scheduler, "_available_cpus", lambda: {1, 2, 3})
+
+    nodes = discover_nodes(0.5)
+
+    assert [(node.node_id, node.cpus, node.memory_mb) for node in nodes] == [(0, [1, 2, 3], 4096)]
+
+
+def test_discover_nodes_without_numa(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setattr(job_scheduler, "NODE_PATH", tmp_path)
+    monkeypatch.setattr(job_scheduler, "_available_cpus", lambda: {0, 1})
+    monkeypatch.setattr(job_scheduler, "_host_memory_mb", lambda: 1000)
+
+    assert [(node.node_id, node.cpus, node.memory_mb) for node in discover_nodes(0.5)] == [(0, [0, 1], 500)]
+
+
+def test_limit_args_pin_only_when_enabled(monkeypatch: pytest.MonkeyPatch) -> None:
+    allocation = Allocation(node=1, cpus=[4, 5, 6], memory_mb=2048)
+
+    assert DockerManager._limit_args(allocation) == ["--cpus", "3", "--memory", "2048m", "--memory-swap", "2048m"]
+    monkeypatch.setitem(DOCKER_SETTINGS["limits"], "pin_cpus", True)
+    assert DockerManager._limit_args(allocation)[-4:] == ["--cpuset-cpus", "4-6", "--cpuset-mems", "1"]
@@ -0,0 +1,369 @@
+"""Tests of the analysis workflow in joern_analyzer.py on the offline backend."""
+
+import json
+import time
+from pathlib import Path
+from types import SimpleNamespace
+from typing import Any, List, Optional, Tuple
+
+import click
+import pytest
+
+import joern_analyzer
+from generate_test_code import GeneratorParameters, generate_codebase
+from joern_analyzer import JoernAnalyzer, ScratchSpaceError, batch_code_root, run_batch
+from settings import ANALYSIS_SETTINGS, DOCKER_SETTINGS, OFFLINE_SETTINGS
+from utils.job_scheduler import Allocation
+from utils.offline_docker_manager import OfflineDockerManager
+
+
+def _fail_c2cpg(
+    monkeypatch: pytest.MonkeyPatch, bad_file: Optional[str] = None, delay: float = 0.0, error: str = "parse error"
+) -> List[Optional[List[str]]]:
+    """Make c2cpg fail with the error on the whole code and on chunks with the bad file.
+
+    Returns:
+        List[Optional[List[str]]]: Files of each c2cpg run, None for the whole code
+    """
+    runs: List[Optional[List[str]]] = []
+    emulate = OfflineDockerManager._emulate
+
+    def failing(self: OfflineDockerManager, command: List[str]) -> Tuple[bool, str, str]:
+        if any(arg.endswith("c2cpg.sh") for arg in command):
+            if "--compilation-database" not in command:
+                runs.append(None)
+                return False, "", error
+            database = self._host_path(command[command.index("--compilation-database") + 1])
+            files = [entry["file"].split("/app/", 1)[1] for entry in json.loads(database.read_text())]
+            runs.append(files)
+            time.sleep(delay)
+            if bad_file in files:
+                return False, "", error
+        return emulate(self, command)
+
+    monkeypatch.setattr(OfflineDockerManager, "_emulate", failing)
+    return runs
+
+
+def test_replays_recorded_output(workdir: Path, test_code: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setitem(OFFLINE_SETTINGS, "replay", str(test_code / "simple_results.json"))
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.analyze(test_code / "simple", workdir / "results" / "simple")
+
+    recorded: Any = json.loads((test_code / "simple_results.json").read_text())
+    assert len(analyzer.functions_info) == len(recorded["functions"])
+    assert len(analyzer.call_graph) == len(recorded["call_graph"])
+    assert analyzer.timings.status == "success"
+    assert (workdir / "results" / "simple" / "timings.json").exists()
+
+
+def test_replays_recorded_output_next_to_the_code(workdir: Path, test_code: Path) -> None:
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.analyze(test_code / "simple", workdir / "results" / "simple")
+
+    recorded: Any = json.loads((test_code / "simple_results.json").read_text())
+    assert len(analyzer.functions_info) == len(recorded["functions"])
+
+
+def test_fails_without_output_for_the_code(workdir: Path) -> None:
+    code_path = workdir / "plain"
+    code_path.mkdir()
+    (code_path / "main.c").write_text("int main(void) { return 0; }\n")
+
+    with pytest.raises(RuntimeError):
+        JoernAnalyzer(backend="offline").analyze(code_path, workdir / "results" / "plain")
+    timings = json.loads((workdir / "results" / "plain" / "timings.json").read_text())
+    assert timings["status"] == "failure"
+
+
+def test_synthesizes_output_of_generated_code(workdir: Path, generated_code: Path) -> None:
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.analyze(generated_code, workdir / "results" / "generated")
+
+    manifest = json.loads((generated_code / "manifest.json").read_text())
+    defined = {function["name"] for function in analyzer.functions_info if function["file"] != "<unknown>"}
+    assert len(defined - {"<global>"}) == manifest["functions"]
+    assert analyzer.timings.status == "success"
+
+
+def test_signatures_mode(workdir: Path, generated_code: Path) -> None:
+    full = JoernAnalyzer(backend="offline", mode="full")
+    full.analyze(generated_code, workdir / "results" / "full")
+    signatures = JoernAnalyzer(backend="offline", mode="signatures")
+    signatures.analyze(generated_code, workdir / "results" / "signatures")
+
+    assert signatures.functions_info
+    assert all("code" not in function for function in signatures.functions_info)
+    assert not any(call["name"].startswith("<operator>") for call in signatures.call_graph)
+    assert signatures.timings.to_dict()["mode"] == "signatures"
+    cleaned = [
+        json.loads((workdir / "results" / mode / "call_graph_clean.json").read_text())
+        for mode in ("full", "signatures")
+    ]
+    assert [len(calls) for calls in cleaned] == [len(cleaned[0])] * 2
+
+
+def test_no_parse_report_in_signatures_mode(monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setitem(ANALYSIS_SETTINGS, "parse_report", True)
+
+    assert JoernAnalyzer(backend="offline", mode="full").parse_report
+    assert not JoernAnalyzer(backend="offline", mode="signatures").parse_report
+
+
+def test_unknown_mode() -> None:
+    with pytest.raises(ValueError):
+        JoernAnalyzer(backend="offline", mode="bodies")
+
+
+def test_isolates_the_failing_file_in_chunks(
+    workdir: Path, generated_code: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    monkeypatch.setitem(ANALYSIS_SETTINGS, "isolation_chunk_files", 4)
+    runs = _fail_c2cpg(monkeypatch, bad_file="src/d0000/file_5.c")
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.analyze(generated_code, workdir / "results" / "generated")
+
+    # The whole code, then chunks of 4 files; failing chunks are halved down to the file
+    assert runs[0] is None
+    chunks = [files for files in runs[1:] if files is not None]
+    assert all(len(files) <= 4 for files in chunks)
+    assert [files for files in chunks if "src/d0000/file_5.c" in files][-1] == ["src/d0000/file_5.c"]
+    parsed = {file for files in chunks if "src/d0000/file_5.c" not in files for file in files}
+    assert parsed | {"src/d0000/file_5.c"} == {file for files in chunks for file in files}
+    assert {"main.c", "src/d0000/file_4.c", "src/d0000/file_6.c"} <= parsed
+    assert analyzer.skipped_files == [{"file": "src/d0000/file_5.c", "reason": "error"}]
+    assert analyzer.timings.status == "partial"
+    assert analyzer.functions_info
+    results_path = workdir / "results" / "generated"
+    assert json.loads((results_path / "skipped_files.json").read_text()) == analyzer.skipped_files
+    assert not (results_path / "chunks").exists()
+
+
+def test_keeps_cpgs_in_the_scratch_space(workdir: Path, generated_code: Path) -> None:
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.analyze(generated_code, workdir / "results" / "generated")
+
+    assert analyzer.cpg_files == ["/scratch/cpg.bin"]
+    assert not list((workdir / "results" / "generated").rglob("*.bin"))
+    assert (workdir / "results" / "generated" / "functions.json").exists()
+
+
+def test_heap_excludes_the_scratch_space() -> None:
+    analyzer = JoernAnalyzer(backend="offline")
+    limits, scratch = DOCKER_SETTINGS["limits"], DOCKER_SETTINGS["scratch"]
+    analyzer.scratch_mb = scratch["min_size_mb"]
+    analyzer.allocation = Allocation(node=0, cpus=[0], memory_mb=limits["min_memory_mb"] + 1000 + analyzer.scratch_mb)
+
+    heap_mb = int((limits["min_memory_mb"] + 1000) * limits["heap_fraction"])
+    assert analyzer._java_opts()[-1] == f"-Xmx{heap_mb}m"
+    assert sum(opt.startswith("-Xmx") for opt in analyzer._java_opts()) == 1
+
+
+def test_full_scratch_space_fails_the_job(workdir: Path, generated_code: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    runs = _fail_c2cpg(monkeypatch, error="java.io.IOException: No space left on device")
+    analyzer = JoernAnalyzer(backend="offline")
+
+    with pytest.raises(ScratchSpaceError):
+        analyzer.analyze(generated_code, workdir / "results" / "generated")
+    assert runs == [None]
+    assert analyzer.scratch_mb == DOCKER_SETTINGS["scratch"]["min_size_mb"]
+    assert analyzer.timings.status == "failure"
+
+
+def test_runs_the_pipeline_in_one_exec(workdir: Path, generated_code: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    commands: List[List[str]] = []
+    execute_command = OfflineDockerManager.execute_command
+
+    def recording(self: OfflineDockerManager, command: List[str], *args: Any, **kwargs: Any) -> Tuple[bool, str, str]:
+        commands.append(list(command))
+        return execute_command(self, command, *args, **kwargs)
+
+    monkeypatch.setattr(OfflineDockerManager, "execute_command", recording)
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.analyze(generated_code, workdir / "results" / "generated")
+
+    assert len([command for command in commands if any(arg.endswith("pipeline.sh") for arg in command)]) == 1
+    assert not any(arg.endswith("c2cpg.sh") for command in commands for arg in command)
+    assert {"directory_setup", "c2cpg_import", "script_run"} <= set(analyzer.timings.phases)
+    assert not (workdir / "results" / "generated" / "pipeline_events.jsonl").exists()
+
+
+def test_reports_a_failed_pipeline_exec(workdir: Path, generated_code: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    execute_command = OfflineDockerManager.execute_command
+
+    def failing(self: OfflineDockerManager, command: List[str], *args: Any, **kwargs: Any) -> Tuple[bool, str, str]:
+        if any(arg.endswith("pipeline.sh") for arg in command):
+            return False, "", "Error response from daemon: container is not running\n"
+        return execute_command(self, command, *args, **kwargs)
+
+    monkeypatch.setattr(OfflineDockerManager, "execute_command", failing)
+    analyzer = JoernAnalyzer(backend="offline")
+
+    with pytest.raises(RuntimeError, match="Failed to run the pipeline: Error response from daemon"):
+        analyzer.analyze(generated_code, workdir / "results" / "generated")
+    assert analyzer.timings.status == "failure"
+
+
+def test_batch_runs_each_directory_in_a_warm_container(
+    workdir: Path, generated_code: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    other = workdir / "other"
+    generate_codebase(other, GeneratorParameters(files=3, functions_per_file=2, seed=2))
+    starts: List[str] = []
+    start_container = OfflineDockerManager.start_container
+
+    def recording(self: OfflineDockerManager, *args: Any, **kwargs: Any) -> bool:
+        starts.append(self.image)
+        return start_container(self, *args, **kwargs)
+
+    commands: List[List[str]] = []
+    execute_command = OfflineDockerManager.execute_command
+
+    def recording_command(
+        self: OfflineDockerManager, command: List[str], *args: Any, **kwargs: Any
+    ) -> Tuple[bool, str, str]:
+        commands.append(list(command))
+        return execute_command(self, command, *args, **kwargs)
+
+    monkeypatch.setattr(OfflineDockerManager, "start_container", recording)
+    monkeypatch.setattr(OfflineDockerManager, "execute_command", recording_command)
+    summaries = run_batch([generated_code, other], 1, backend="offline")
+
+    assert [summary["status"] for summary in summaries] == ["success", "success"]
+    assert [summary["functions"] > 0 for summary in summaries] == [True, True]
+    assert summaries[0]["results_path"] != summaries[1]["results_path"]
+    assert len(starts) == 1
+    # The jobs use their directories in the warm container, not /app and /results
+    arguments = " ".join(arg for command in commands for arg in command)
+    assert "/batch/code/generated" in arguments and "/batch/code/other" in arguments
+    assert "/app" not in arguments and "/results/" not in arguments.replace("/batch/results/", "")
+    timings = json.loads((Path(summaries[0]["results_path"]) / "timings.json").read_text())
+    assert "scratch_cleanup" in timings["phases"] and "container_stop" not in timings["phases"]
+
+
+def test_batch_empties_the_scratch_space_after_each_job(
+    workdir: Path, generated_code: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    other = workdir / "other"
+    generate_codebase(other, GeneratorParameters(files=3, functions_per_file=2, seed=2))
+    starts: List[str] = []
+    start_container = OfflineDockerManager.start_container
+    emulate = OfflineDockerManager._emulate
+
+    def recording(self: OfflineDockerManager, *args: Any, **kwargs: Any) -> bool:
+        starts.append(self.image)
+        return start_container(self, *args, **kwargs)
+
+    def failing_cleanup(self: OfflineDockerManager, command: List[str]) -> Tuple[bool, str, str]:
+        if command[0] == "find":
+            assert list(self._host_path(command[1]).iterdir())
+            return False, "", "find: cannot delete"
+        return emulate(self, command)
+
+    monkeypatch.setattr(OfflineDockerManager, "start_container", recording)
+    monkeypatch.setattr(OfflineDockerManager, "_emulate", failing_cleanup)
+    summaries = run_batch([generated_code, other], 1, backend="offline")
+
+    assert [summary["status"] for summary in summaries] == ["success", "success"]
+    for summary in summaries:
+        timings = json.loads((Path(summary["results_path"]) / "timings.json").read_text())
+        assert {"scratch_cleanup", "container_stop"} <= set(timings["phases"])
+    # A container whose scratch space cannot be emptied is not reused
+    assert len(starts) == 2
+
+
+def test_batch_code_root_refuses_broad_roots(tmp_path: Path) -> None:
+    first, second = tmp_path / "a" / "x", tmp_path / "b" / "y"
+
+    assert batch_code_root([first, second]) == tmp_path
+    assert batch_code_root([first], tmp_path / "a") == (tmp_path / "a").resolve()
+    with pytest.raises(click.BadParameter):
+        batch_code_root([Path("/srv/x"), Path("/home/y")])
+    with pytest.raises(click.BadParameter):
+        batch_code_root([Path("/home/a"), Path("/home/b")])
+    with pytest.raises(click.BadParameter):
+        batch_code_root([first], Path("/"))
+    with pytest.raises(click.BadParameter):
+        batch_code_root([first], tmp_path / "b")
+
+
+def test_keeps_only_the_frontend_report_rows(monkeypatch: pytest.MonkeyPatch) -> None:
+    output = "[DEBUG] lots of log\n| /app/main.c | 12 | yes | yes | 15 ms |\n"
+    analyzer = JoernAnalyzer(backend="offline")
+
+    analyzer._collect_frontend_report(output)
+    assert analyzer.frontend_report == {}
+
+    monkeypatch.setitem(ANALYSIS_SETTINGS, "parse_report", True)
+    analyzer._collect_frontend_report(output)
+    assert list(analyzer.frontend_report) == ["main.c"]
+
+
+def test_skips_the_files_left_at_the_deadline(
+    workdir: Path, generated_code: Path, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    monkeypatch.setitem(ANALYSIS_SETTINGS, "isolation_chunk_files", 2)
+    monkeypatch.setitem(ANALYSIS_SETTINGS, "timeout", {**ANALYSIS_SETTINGS["timeout"], "job": 6, "analysis_reserve": 3})
+    _fail_c2cpg(monkeypatch, delay=1.0)
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.analyze(generated_code, workdir / "results" / "generated")
+
+    assert analyzer.cpg_files
+    assert analyzer.skipped_files
+    assert {skipped["reason"] for skipped in analyzer.skipped_files} == {"deadline"}
+    assert analyzer.timings.status == "partial"
+
+
+def test_isolates_a_hanging_file_within_the_job_timeout(workdir: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    code_path = workdir / "many_files"
+    generate_codebase(code_path, GeneratorParameters(files=64, functions_per_file=1, seed=3))
+    hanging = "src/d0000/file_1.c"
+    clock = [0.0]
+    timeouts: List[int] = []
+    monkeypatch.setattr(joern_analyzer, "time", SimpleNamespace(monotonic=lambda: clock[0]))
+    emulate = OfflineDockerManager._emulate
+
+    def hanging_c2cpg(self: OfflineDockerManager, command: List[str]) -> Tuple[bool, str, str]:
+        # c2cpg runs until it is killed on the hanging file, and for 10 seconds otherwise
+        if any(arg.endswith("c2cpg.sh") for arg in command):
+            timeout = int(command[command.index("KILL") + 1])
+            if "--compilation-database" not in command:
+                clock[0] += timeout
+                return False, "", ""
+            database = self._host_path(command[command.index("--compilation-database") + 1])
+            files = [entry["file"].split("/app/", 1)[1] for entry in json.loads(database.read_text())]
+            timeouts.append(timeout)
+            if hanging in files:
+                clock[0] += timeout
+                return False, "", ""
+            clock[0] += 10
+        return emulate(self, command)
+
+    monkeypatch.setattr(OfflineDockerManager, "_emulate", hanging_c2cpg)
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.analyze(code_path, workdir / "results" / "many_files")
+
+    timeout = ANALYSIS_SETTINGS["timeout"]
+    assert max(timeouts) <= (timeout["job"] - timeout["analysis_reserve"]) * ANALYSIS_SETTINGS["isolation_chunk_budget"]
+    assert analyzer.skipped_files == [{"file": hanging, "reason": "timeout"}]
+    assert analyzer.timings.status == "partial"
+    assert clock[0] <= timeout["job"] - timeout["analysis_reserve"]
+
+
+def test_chunk_databases_keep_the_shipped_flags(tmp_path: Path) -> None:
+    analyzer = JoernAnalyzer(backend="offline")
+    analyzer.results_path = tmp_path
+    analyzer.database_entries = [
+        {"directory": "/app", "file": "/app/a.c", "arguments": ["cc", "-DA", "-c", "/app/a.c"]},
+        {"directory": "/app", "file": "/app/b.c", "arguments": ["cc", "-DB", "-c", "/app/b.c"]},
+    ]
+
+    args = analyzer._chunk_database_args(["b.c"], 1)
+    assert args == ["--compilation-database", "/results/chunks/compile_commands_1.json"]
+    assert json.loads((tmp_path / "chunks" / "compile_commands_1.json").read_text()) == [analyzer.database_entries[1]]
+
+    analyzer.database_entries = []
+    analyzer._chunk_database_args(["c.c"], 2)
+    assert json.loads((tmp_path / "chunks" / "compile_commands_2.json").read_text()) == [
+        {"directory": "/app", "file": "/app/c.c", "arguments": ["cc", "-c", "/app/c.c"]}
+    ]
@@ -0,0 +1,62 @@
+"""Tests of the phase timings and metrics registry in utils/metrics.py."""
+
+import json
+from pathlib import Path
+
+import pytest
+
+from utils.metrics import METRICS, MetricsRegistry, RunTimings
+
+
+def test_histogram_and_counter_rendering() -> None:
+    registry = MetricsRegistry()
+    registry.histogram("duration_seconds", "Durations.", (1, 10))
+    registry.counter("runs_total", "Runs.")
+    registry.observe("duration_seconds", 0.5, phase="parse")
+    registry.observe("duration_seconds", 5, phase="parse")
+    registry.observe("duration_seconds", 50, phase="parse")
+    registry.inc("runs_total", status="success")
+    registry.inc("runs_total", 2, status='a"b')
+
+    lines = registry.render().splitlines()
+
+    assert "# TYPE duration_seconds histogram" in lines
+    assert 'duration_seconds_bucket{phase="parse",le="1"} 1' in lines
+    assert 'duration_seconds_bucket{phase="parse",le="10"} 2' in lines
+    assert 'duration_seconds_bucket{phase="parse",le="+Inf"} 3' in lines
+    assert 'duration_seconds_sum{phase="parse"} 55.5' in lines
+    assert 'duration_seconds_count{phase="parse"} 3' in lines
+    assert "# TYPE runs_total counter" in lines
+    assert 'runs_total{status="success"} 1' in lines
+    assert 'runs_total{status="a\\"b"} 2' in lines
+    assert any(line.startswith("process_max_resident_memory_bytes ") for line in lines)
+
+
+def test_undeclared_metrics_are_rejected() -> None:
+    with pytest.raises(KeyError):
+        MetricsRegistry().observe("missing", 1)
+
+
+def test_run_timings(tmp_path: Path) -> None:
+    output = tmp_path / "output.json"
+    output.write_text("[1, 2]")
+    timings = RunTimings()
+
+    with timings.phase("parse"):
+        pass
+    with pytest.raises(RuntimeError):
+        with timings.phase("parse"):
+            raise RuntimeError("phase failed")
+    timings.record_size(output)
+    timings.record_size(tmp_path / "missing.json")
+    timings.record_count("functions", 2)
+    timings.finish(success=True)
+    timings.save(tmp_path / "timings.json")
+
+    saved = json.loads((tmp_path / "timings.json").read_text())
+    assert saved["status"] == "success"
+    assert list(saved["phases"]) == ["parse"]
+    assert saved["total_seconds"] >= saved["phases"]["parse"] >= 0
+    assert saved["sizes"] == {"output.json": 6}
+    assert saved["counts"] == {"functions": 2}
+    assert 'joern_analyzer_phase_duration_seconds_count{phase="parse"}' in METRICS.render()
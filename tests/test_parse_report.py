@@ -0,0 +1,61 @@
+"""Tests of the per-file parse cost report in utils/parse_report.py."""
+
+import pytest
+
+from utils.parse_report import build_parse_report, parse_frontend_report
+
+C2CPG_OUTPUT = """[INFO ] Running c2cpg
+| File                  | LOC | Parsed | Got a CPG | CPG generation duration |
+|-----------------------|-----|--------|-----------|-------------------------|
+| /app/src/tables.c     | 900 | yes    | yes       | 1s 234ms                |
+| /app/main.c           | 12  | yes    | yes       | 15 ms                   |
+| /app/broken.c         | 40  | no     | no        | -                       |
+| /app/macros.h         | 300 | yes    | no        | 2m 1.5s                 |
+[INFO ] Done | 3 files | 1s
+"""
+
+
+def test_parse_frontend_report() -> None:
+    report = parse_frontend_report(C2CPG_OUTPUT)
+
+    assert report == {
+        "src/tables.c": {"loc": 900, "parsed": True, "cpg": True, "seconds": pytest.approx(1.234)},
+        "main.c": {"loc": 12, "parsed": True, "cpg": True, "seconds": pytest.approx(0.015)},
+        "macros.h": {"loc": 300, "parsed": True, "cpg": False, "seconds": pytest.approx(121.5)},
+    }
+
+
+def test_parse_frontend_report_without_table() -> None:
+    assert parse_frontend_report("") == {}
+    assert parse_frontend_report("| a | b | c | d | e |\n| x.c | 1 | yes | yes | soon |") == {}
+
+
+def test_build_parse_report() -> None:
+    file_nodes = [
+        {"file": "/app/main.c", "methods": 2, "nodes": 80},
+        {"file": "/app/util.c", "methods": 5, "nodes": 500},
+        {"file": "/app/empty.c", "methods": 0, "nodes": 0},
+        {"file": "<unknown>", "methods": 9, "nodes": 900},
+    ]
+
+    report = build_parse_report(parse_frontend_report(C2CPG_OUTPUT), file_nodes)
+
+    assert [entry["file"] for entry in report] == ["macros.h", "src/tables.c", "main.c", "util.c", "empty.c"]
+    assert report[2] == {
+        "file": "main.c",
+        "seconds": pytest.approx(0.015),
+        "loc": 12,
+        "parsed": True,
+        "cpg": True,
+        "methods": 2,
+        "nodes": 80,
+    }
+    assert report[3] == {
+        "file": "util.c",
+        "seconds": None,
+        "loc": None,
+        "parsed": None,
+        "cpg": None,
+        "methods": 5,
+        "nodes": 500,
+    }
@@ -0,0 +1,89 @@
+"""Tests of the reachability index in utils/reachability.py."""
+
+import json
+import random
+from typing import Dict, Set
+
+from utils.call_graph import CallGraph
+from utils.reachability import ReachabilityIndex
+
+
+def _random_graph(rng: random.Random, num_nodes: int, num_edges: int) -> CallGraph:
+    names = [f"f{node}" for node in range(num_nodes)]
+    pairs = [(rng.randrange(num_nodes), rng.randrange(num_nodes)) for _ in range(num_edges)]
+    return CallGraph.from_edges(names, pairs)
+
+
+def _reachable(graph: CallGraph, root: int) -> Set[int]:
+    seen, stack = {root}, [root]
+    while stack:
+        for callee in graph.successors(stack.pop()):
+            if callee not in seen:
+                seen.add(callee)
+                stack.append(callee)
+    return seen
+
+
+def test_from_calls_skips_global_and_deduplicates() -> None:
+    graph = CallGraph.from_calls(
+        [{"method": "main", "name": "f"}, {"method": "main", "name": "f"}, {"method": "<global>", "name": "g"}],
+        functions=("lonely",),
+    )
+
+    assert sorted(graph.names) == ["f", "lonely", "main"]
+    assert graph.num_edges == 1
+    assert list(graph.successors(graph.ids["main"])) == [graph.ids["f"]]
+
+
+def test_can_reach_matches_search() -> None:
+    rng = random.Random(11)
+    for seed in range(10):
+        graph = _random_graph(rng, rng.randint(1, 40), rng.randint(0, 80))
+        sinks = [name for name in graph.names if rng.random() < 0.2]
+        index = ReachabilityIndex.build(graph, sinks, num_intervals=2, seed=seed)
+
+        for source in range(graph.num_nodes):
+            reachable = _reachable(graph, source)
+            for target in range(graph.num_nodes):
+                expected = target in reachable
+                assert index.can_reach(graph.names[source], graph.names[target]) == expected
+
+
+def test_can_reach_is_reflexive_and_unknown_is_unreachable() -> None:
+    graph = CallGraph.from_calls([{"method": "main", "name": "f"}])
+    index = ReachabilityIndex.build(graph, ["f"])
+
+    assert index.can_reach("main", "main")
+    assert index.can_reach("main", "f")
+    assert not index.can_reach("f", "main")
+    assert not index.can_reach("main", "missing")
+    assert index.unknown_functions(["main", "missing"]) == {"missing"}
+
+
+def test_reachable_targets_with_sinks_and_other_targets() -> None:
+    calls = [("main", "a"), ("a", "b"), ("b", "a"), ("b", "system"), ("main", "printf"), ("c", "system")]
+    graph = CallGraph.from_calls([{"method": caller, "name": callee} for caller, callee in calls])
+    index = ReachabilityIndex.build(graph, ["system", "printf", "not_called"])
+
+    assert index.sinks == ["printf", "system"]
+    assert index.reachable_targets(["main", "a", "c", "missing"]) == {
+        "main": ["printf", "system"],
+        "a": ["system"],
+        "c": ["system"],
+    }
+    assert index.reachable_targets(["main", "c"], ["b", "c"]) == {"main": ["b"], "c": ["c"]}
+
+
+def test_round_trip() -> None:
+    rng = random.Random(5)
+    graph = _random_graph(rng, 30, 60)
+    index = ReachabilityIndex.build(graph, graph.names[:5])
+    loaded = ReachabilityIndex.from_dict(json.loads(json.dumps(index.to_dict())))
+
+    answers: Dict[bool, int] = {True: 0, False: 0}
+    for source in graph.names:
+        for target in graph.names:
+            expected = index.can_reach(source, target)
+            assert loaded.can_reach(source, target) == expected
+            answers[expected] += 1
+    assert answers[True] and answers[False]
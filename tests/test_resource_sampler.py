@@ -0,0 +1,74 @@
+"""Tests of the cgroup parsing in utils/resource_sampler.py."""
+
+from utils.resource_sampler import parse_cgroup_stats
+
+CGROUP_V2 = """== cpu.stat
+usage_usec 2500000
+user_usec 2000000
+system_usec 500000
+nr_throttled 3
+throttled_usec 250000
+== memory.current
+104857600
+== memory.peak
+209715200
+== memory.events
+low 0
+high 0
+max 2
+oom 1
+oom_kill 1
+== io.stat
+8:0 rbytes=4096 wbytes=8192 rios=1 wios=2 dbytes=0 dios=0
+8:16 rbytes=1024 wbytes=0 rios=3 wios=0 dbytes=0 dios=0
+"""
+
+CGROUP_V1 = """== cpuacct/cpuacct.usage
+3000000000
+== memory/memory.usage_in_bytes
+1048576
+== memory/memory.max_usage_in_bytes
+2097152
+== blkio/blkio.throttle.io_service_bytes
+8:0 Read 4096
+8:0 Write 512
+8:0 Total 4608
+Total 4608
+== blkio/blkio.throttle.io_serviced
+8:0 Read 2
+8:0 Write 1
+8:0 Total 3
+"""
+
+
+def test_parse_cgroup_v2() -> None:
+    assert parse_cgroup_stats(CGROUP_V2) == {
+        "container_cpu_seconds": 2.5,
+        "container_cpu_user_seconds": 2.0,
+        "container_cpu_system_seconds": 0.5,
+        "container_cpu_throttled_seconds": 0.25,
+        "container_memory_current_bytes": 104857600,
+        "container_memory_peak_bytes": 209715200,
+        "container_oom_kills": 1,
+        "container_io_read_bytes": 5120,
+        "container_io_write_bytes": 8192,
+        "container_io_read_ops": 4,
+        "container_io_write_ops": 2,
+    }
+
+
+def test_parse_cgroup_v1() -> None:
+    assert parse_cgroup_stats(CGROUP_V1) == {
+        "container_cpu_seconds": 3.0,
+        "container_memory_current_bytes": 1048576,
+        "container_memory_peak_bytes": 2097152,
+        "container_io_read_bytes": 4096,
+        "container_io_write_bytes": 512,
+        "container_io_read_ops": 2,
+        "container_io_write_ops": 1,
+    }
+
+
+def test_parse_cgroup_missing_and_malformed_files() -> None:
+    assert parse_cgroup_stats("") == {}
+    assert parse_cgroup_stats("== memory.current\nmax\n== memory.peak\n42\n") == {"container_memory_peak_bytes": 42}
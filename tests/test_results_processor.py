@@ -0,0 +1,109 @@
+"""Tests of the results processing in results_processor.py."""
+
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+import pytest
+
+from results_processor import ResultsProcessor
+from utils.file_handler import FileHandler
+
+
+def _results(results_path: Path, calls: Dict[str, List[str]], entry_points: Optional[List[str]]) -> Dict[str, Any]:
+    """Process the results of an analysis defining the keys of calls, each calling its values."""
+    functions = [
+        {"name": name, "file": f"{name}.c", "lineNumber": 1, "signature": f"void {name}(void)", "code": "{}"}
+        for name in calls
+    ]
+    call_graph = [
+        {"method": caller, "name": callee, "file": f"{caller}.c", "lineNumber": 2}
+        for caller, callees in calls.items()
+        for callee in callees
+    ]
+    return ResultsProcessor(results_path, entry_points).get_all_results(functions, call_graph)
+
+
+def test_dead_functions(tmp_path: Path) -> None:
+    calls = {"main": ["used", "printf"], "used": [], "dead": ["used", "dead_callee"], "dead_callee": ["dead"]}
+
+    results = _results(tmp_path, calls, ["main", "missing"])
+
+    assert [(func["name"], func["file"]) for func in results["dead_functions"]] == [
+        ("dead", "dead.c"),
+        ("dead_callee", "dead_callee.c"),
+    ]
+
+
+def test_dead_functions_of_every_entry_point(tmp_path: Path) -> None:
+    results = _results(tmp_path, {"main": [], "handler": ["helper"], "helper": []}, ["main", "handler"])
+
+    assert results["dead_functions"] == []
+
+
+def test_no_dead_functions_without_entry_points(tmp_path: Path) -> None:
+    results = _results(tmp_path, {"init": [], "unused": []}, ["main"])
+
+    assert results["dead_functions"] == []
+
+
+def test_functions_without_code_are_defined(tmp_path: Path) -> None:
+    functions = [
+        {"name": "main", "file": "main.c", "lineNumber": 1, "signature": "int main(void)"},
+        {"name": "empty", "file": "main.c", "lineNumber": 5, "signature": "void empty(void)", "code": "<empty>"},
+        {"name": "<operator>.addition", "file": "main.c", "lineNumber": 1, "signature": ""},
+    ]
+    call_graph = [{"method": "main", "name": "empty", "file": "main.c", "lineNumber": 2}]
+
+    results = ResultsProcessor(tmp_path, ["main"]).get_all_results(functions, call_graph)
+
+    assert [func["name"] for func in results["cleaned_functions"]] == ["main"]
+    assert results["cleaned_call_graph"] == []
+
+
+def test_counts_the_cleaned_functions(tmp_path: Path) -> None:
+    processor = ResultsProcessor(tmp_path, ["main"])
+    functions = [
+        {"name": "main", "file": "main.c", "lineNumber": 1, "signature": "int main(void)", "code": "{}"},
+        {"name": "helper", "file": "main.c", "lineNumber": 5, "signature": "int helper(void)", "code": "{}"},
+        {"name": "<global>", "file": "main.c", "lineNumber": 1, "signature": "", "code": "<global>"},
+    ]
+    call_graph = [{"method": "main", "name": "printf", "file": "main.c", "lineNumber": 2}]
+
+    processor.get_all_results(functions, call_graph)
+
+    assert processor.timings.counts["cleaned_functions"] == 2
+
+
+def test_diff_cache_is_written_atomically_and_recomputed_if_unreadable(tmp_path: Path) -> None:
+    (tmp_path / "old").mkdir()
+    (tmp_path / "new").mkdir()
+    _results(tmp_path / "old", {"main": ["helper"], "helper": []}, ["main"])
+    _results(tmp_path / "new", {"main": ["helper", "added"], "helper": [], "added": []}, ["main"])
+    processor = ResultsProcessor(tmp_path / "new")
+
+    diff = processor.diff_results(tmp_path / "old")
+    cache_file = tmp_path / "new" / "diffs" / "old.json"
+    assert [path.name for path in cache_file.parent.iterdir()] == ["old.json"]
+    assert diff["functions"]["added"] == [{"name": "added", "file": "added.c"}]
+
+    cache_file.write_text('{"functions": {"added": [')
+    assert processor.diff_results(tmp_path / "old") == diff
+    assert processor.diff_results(tmp_path / "old") == diff
+    assert [path.name for path in cache_file.parent.iterdir()] == ["old.json"]
+
+
+def test_export_does_not_load_the_function_code(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    _results(tmp_path, {"main": ["helper", "printf"], "helper": [], "unused": []}, ["main"])
+    read_json = FileHandler.read_json
+
+    def without_functions(file_path: Path) -> Any:
+        assert file_path.name != "functions_clean.json"
+        return read_json(file_path)
+
+    monkeypatch.setattr(FileHandler, "read_json", staticmethod(without_functions))
+    dot = "".join(ResultsProcessor(tmp_path).iter_export("dot"))
+
+    for name in ("main", "helper", "unused", "printf"):
+        assert f'label="{name}"' in dot
+    assert 'label="main", file="main.c"' in dot
+    assert dot.count("->") == 2
@@ -0,0 +1,47 @@
+"""Tests of the load test helpers in simple_rest_client.py."""
+
+import pytest
+
+from simple_rest_client import LoadTestResult, load_test_report, parse_mix, percentile
+
+
+def test_percentile() -> None:
+    values = [float(value) for value in range(1, 101)]
+
+    assert percentile(values, 0.5) == 50
+    assert percentile(values, 0.99) == 99
+    assert percentile(values, 1.0) == 100
+    assert percentile([3.0], 0.0) == 3
+
+
+def test_parse_mix() -> None:
+    assert parse_mix("upload:1,fetch:3") == {"upload": 0.25, "fetch": 0.75}
+    assert parse_mix("fetch") == {"fetch": 1.0}
+    for mix in ("delete:1", "upload:0", "upload:-1,fetch:2", "upload:x"):
+        with pytest.raises(ValueError):
+            parse_mix(mix)
+
+
+def test_load_test_report() -> None:
+    results = [
+        LoadTestResult("fetch", 0.1, True),
+        LoadTestResult("fetch", 0.3, False),
+        LoadTestResult("upload", 0.2, True),
+    ]
+
+    report = load_test_report(results, elapsed=2.0)
+
+    assert list(report) == ["fetch", "upload", "total"]
+    assert report["fetch"] == {
+        "requests": 2,
+        "errors": 1,
+        "error_rate": 0.5,
+        "throughput": 0.5,
+        "p50": 0.1,
+        "p95": 0.3,
+        "p99": 0.3,
+        "max": 0.3,
+    }
+    assert report["total"]["requests"] == 3
+    assert report["total"]["throughput"] == 1.0
+    assert report["total"]["p50"] == 0.2
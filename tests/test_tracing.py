@@ -0,0 +1,107 @@
+"""Tests of the span recording and export in utils/tracing.py."""
+
+import json
+from pathlib import Path
+from typing import Any, Dict, List
+
+import pytest
+
+from utils.tracing import STATUS_ERROR, STATUS_OK, TRACER, Tracer, parse_traceparent
+
+TRACE_ID = "4bf92f3577b34da6a3ce929d0e0e4736"
+PARENT_ID = "00f067aa0ba902b7"
+
+
+def _exported(trace_file: Path) -> List[List[Dict[str, Any]]]:
+    """Get the spans of every exported trace, one list per trace."""
+    return [
+        json.loads(line)["resourceSpans"][0]["scopeSpans"][0]["spans"] for line in trace_file.read_text().splitlines()
+    ]
+
+
+@pytest.mark.parametrize(
+    "traceparent, expected",
+    [
+        (f"00-{TRACE_ID}-{PARENT_ID}-01", (TRACE_ID, PARENT_ID)),
+        (None, None),
+        ("", None),
+        (f"00-{TRACE_ID}-{PARENT_ID}", None),
+        (f"00-{TRACE_ID[:-1]}x-{PARENT_ID}-01", None),
+        (f"00-{'0' * 32}-{PARENT_ID}-01", None),
+        (f"00-{TRACE_ID}-{'0' * 16}-01", None),
+    ],
+)
+def test_parse_traceparent(traceparent: str, expected: Any) -> None:
+    assert parse_traceparent(traceparent) == expected
+
+
+def test_nested_spans_are_exported_with_their_root(tmp_path: Path) -> None:
+    tracer = Tracer("test", "file", tmp_path / "traces.jsonl", "")
+
+    with tracer.span("request", traceparent=f"00-{TRACE_ID}-{PARENT_ID}-01", attributes={"code.id": "x"}) as root:
+        with tracer.span("analysis") as child:
+            assert tracer.current_span() is child
+            child.set_attribute("functions", 3)
+        assert not (tmp_path / "traces.jsonl").exists()
+    assert tracer.current_span() is None
+
+    [spans] = _exported(tmp_path / "traces.jsonl")
+    assert [span["name"] for span in spans] == ["analysis", "request"]
+    assert {span["traceId"] for span in spans} == {TRACE_ID}
+    assert spans[0]["parentSpanId"] == root.span_id
+    assert spans[1]["parentSpanId"] == PARENT_ID
+    assert spans[0]["attributes"] == [{"key": "functions", "value": {"intValue": "3"}}]
+    assert spans[1]["attributes"] == [{"key": "code.id", "value": {"stringValue": "x"}}]
+
+
+def test_failed_spans(tmp_path: Path) -> None:
+    tracer = Tracer("test", "file", tmp_path / "traces.jsonl", "")
+
+    with pytest.raises(ValueError):
+        with tracer.span("request"):
+            raise ValueError("no code")
+
+    [[span]] = _exported(tmp_path / "traces.jsonl")
+    assert span["status"] == {"code": STATUS_ERROR, "message": "no code"}
+    assert "parentSpanId" not in span
+
+
+def test_import_spans(tmp_path: Path) -> None:
+    tracer = Tracer("test", "file", tmp_path / "traces.jsonl", "")
+    spans_file = tmp_path / "spans.json"
+
+    with tracer.span("request") as root:
+        recorded = {"spanId": "1" * 16, "parentSpanId": root.span_id, "startTimeUnixNano": 1, "endTimeUnixNano": 2}
+        spans_file.write_text(
+            json.dumps(
+                [
+                    {**recorded, "traceId": root.trace_id, "name": "cpg", "attributes": {"files": 2, "x": [1]}},
+                    {**recorded, "traceId": TRACE_ID, "name": "other trace"},
+                    "not a span",
+                ]
+            )
+        )
+        assert tracer.import_spans(spans_file) == 1
+    assert not spans_file.exists()
+
+    [spans] = _exported(tmp_path / "traces.jsonl")
+    assert [span["name"] for span in spans] == ["cpg", "request"]
+    assert spans[0]["attributes"] == [{"key": "files", "value": {"intValue": "2"}}]
+    assert spans[0]["status"] == {"code": STATUS_OK}
+
+
+def test_disabled_exporter(tmp_path: Path) -> None:
+    tracer = Tracer("test", "none", tmp_path / "traces.jsonl", "")
+
+    with tracer.span("request"):
+        pass
+
+    assert not (tmp_path / "traces.jsonl").exists()
+
+
+def test_traces_are_not_exported_by_default(trace_file: Path) -> None:
+    with TRACER.span("request"):
+        pass
+
+    assert TRACER.exporter == "none"
+    assert not trace_file.exists()
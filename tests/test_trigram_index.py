@@ -0,0 +1,75 @@
+"""Tests of the trigram search index in utils/trigram_index.py."""
+
+import re
+from typing import Any, Dict, List
+
+import pytest
+
+from utils.trigram_index import TrigramIndex, required_literals, trigrams
+
+FUNCTIONS: List[Dict[str, Any]] = [
+    {"name": "parse", "file": "a.c", "lineNumber": 1, "signature": "int parse(char *)", "code": "return strlen(s);"},
+    {"name": "copy", "file": "a.c", "lineNumber": 9, "signature": "void copy(char *)", "code": "strcpy(d, s);"},
+    {"name": "Main", "file": "m.c", "lineNumber": 1, "signature": "int main(void)", "code": "copy(buf); parse(x);"},
+    {"name": "empty", "file": "m.c", "lineNumber": 7, "signature": "void empty(void)"},
+]
+
+
+def test_trigrams_are_case_folded() -> None:
+    assert trigrams("AbCd") == {"abc", "bcd"}
+    assert trigrams("ab") == set()
+
+
+@pytest.mark.parametrize(
+    "pattern, literals",
+    [
+        ("strcpy", ["strcpy"]),
+        (r"str(cpy|cat)\(", ["str", "("]),
+        ("foo|bar", []),
+        ("ab*cd", ["a", "cd"]),
+        ("abc?def", ["ab", "def"]),
+        ("x{2,3}yz", ["yz"]),
+        ("abc[xyz]def", ["abc", "def"]),
+        (r"abc[^]x]def", ["abc", "def"]),
+        (r"\bmalloc\s*\(", ["malloc", "("]),
+        (r"a\x41bc", ["a", "bc"]),
+        (r"a\u00e9bcd", ["a", "bcd"]),
+        (r"(ab)\1cd", ["cd"]),
+        (r"free\.", ["free."]),
+        ("a.b", ["a", "b"]),
+    ],
+)
+def test_required_literals(pattern: str, literals: List[str]) -> None:
+    assert required_literals(pattern) == literals
+
+
+def test_required_literals_are_in_every_match() -> None:
+    text = "strcpy(a, b); strcat(c, d); memcpy(e, f, 4);"
+    for pattern in [r"str(cpy|cat)\(", r"mem\w+\(e", r"[ms]\w+cpy\(", r"(a|c), [bd]"]:
+        for match in re.finditer(pattern, text):
+            for literal in required_literals(pattern):
+                assert literal in match.group(0)
+
+
+@pytest.mark.parametrize(
+    "query, regex", [("strcpy", False), ("STR", False), ("str", False), (r"str(len|cpy)", True), (r"ma.n", True)]
+)
+def test_search_matches_scan(query: str, regex: bool) -> None:
+    index = TrigramIndex.build(FUNCTIONS)
+    compiled = re.compile(query)
+    expected = [
+        function["name"]
+        for function in FUNCTIONS
+        if (compiled.search if regex else lambda text: query in text)(TrigramIndex.document_text(function))
+    ]
+
+    assert [match["name"] for match in index.search(FUNCTIONS, query, regex=regex)] == expected
+
+
+def test_search_limit_and_round_trip() -> None:
+    index = TrigramIndex.from_dict(TrigramIndex.build(FUNCTIONS).to_dict())
+
+    assert [match["name"] for match in index.search(FUNCTIONS, "char", limit=1)] == ["parse"]
+    assert index.candidates("(?x) s t r", regex=True) == list(range(len(FUNCTIONS)))
+    with pytest.raises(re.error):
+        index.search(FUNCTIONS, "(", regex=True)
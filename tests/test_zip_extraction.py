@@ -0,0 +1,73 @@
+"""Tests of the background zip extraction in utils/zip_extraction.py."""
+
+import threading
+import zipfile
+from pathlib import Path
+
+import pytest
+
+from utils.zip_extraction import ZipExtraction
+
+
+def _zip(path: Path) -> Path:
+    with zipfile.ZipFile(path, "w") as archive:
+        archive.writestr("src/main.c", "int main(void) { return 0; }\n")
+        archive.writestr("src/util.h", "int util(void);\n")
+        archive.writestr("README", "not a source file\n")
+    return path
+
+
+def test_extracts_in_the_background(tmp_path: Path) -> None:
+    extraction = ZipExtraction(_zip(tmp_path / "code.zip"), tmp_path / "code")
+
+    assert extraction.source_bytes == len("int main(void) { return 0; }\n") + len("int util(void);\n")
+    extraction.start().wait()
+
+    assert (tmp_path / "code" / "src" / "main.c").exists()
+    assert (tmp_path / "code" / "README").exists()
+    assert (tmp_path / "code").resolve() == extraction.directory
+    assert not (tmp_path / "code.zip").exists()
+
+
+def test_publishes_the_code_only_when_complete(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    extracting, proceed = threading.Event(), threading.Event()
+    extractall = zipfile.ZipFile.extractall
+
+    def blocking(self: zipfile.ZipFile, *args: object, **kwargs: object) -> None:
+        extracting.set()
+        proceed.wait(5)
+        extractall(self, *args, **kwargs)  # type: ignore[arg-type]
+
+    monkeypatch.setattr(zipfile.ZipFile, "extractall", blocking)
+    finished = threading.Event()
+    extraction = ZipExtraction(_zip(tmp_path / "code.zip"), tmp_path / "code", on_finished=finished.set)
+    extraction.start()
+
+    assert extracting.wait(5)
+    assert not (tmp_path / "code").exists()
+    assert not finished.is_set()
+    proceed.set()
+    extraction.wait()
+    assert finished.is_set()
+    assert (tmp_path / "code" / "src" / "main.c").exists()
+
+
+def test_rejects_files_that_are_not_zip_archives(tmp_path: Path) -> None:
+    (tmp_path / "code.zip").write_text("not a zip file")
+
+    with pytest.raises(zipfile.BadZipFile):
+        ZipExtraction(tmp_path / "code.zip", tmp_path / "code")
+
+
+def test_removes_the_directory_of_a_failed_extraction(tmp_path: Path) -> None:
+    finished = threading.Event()
+    extraction = ZipExtraction(_zip(tmp_path / "code.zip"), tmp_path / "code", on_finished=finished.set)
+    # Truncate the archive after its index was read
+    (tmp_path / "code.zip").write_bytes((tmp_path / "code.zip").read_bytes()[:20])
+
+    with pytest.raises(RuntimeError):
+        extraction.start().wait()
+    assert finished.is_set()
+    assert not (tmp_path / "code").exists()
+    assert not extraction.directory.exists()
+    assert not (tmp_path / "code.zip").exists()
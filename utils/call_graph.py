@@ -0,0 +1,384 @@
+"""Call Graph Module
+
+This module provides a compact, interned representation of a call graph together with
+the graph algorithms that the results pipeline runs on it.
+
+Function names are interned to dense integer ids and the edges are stored in compressed
+sparse row (CSR) form: the callees of node ``v`` are ``targets[offsets[v]:offsets[v + 1]]``.
+All traversals are iterative so that large graphs never hit Python's recursion limit.
+"""
+
+from array import array
+from bisect import bisect_left
+from typing import Any, Dict, Iterable, List, Optional, Tuple
+
+
+class CallGraph:
+    """An interned call graph stored as CSR adjacency arrays.
+
+    Attributes:
+        names (List[str]): Function name of each node id
+        ids (Dict[str, int]): Mapping of function names to node ids
+        offsets (array): CSR row offsets, ``num_nodes + 1`` entries
+        targets (array): CSR column indices (callee node ids), sorted and deduplicated per row
+    """
+
+    def __init__(self, names: List[str], offsets: array, targets: array):
+        """Initialize the call graph from already interned CSR arrays.
+
+        Args:
+            names (List[str]): Function name of each node id
+            offsets (array): CSR row offsets
+            targets (array): CSR column indices
+        """
+        self.names = names
+        self.ids = {name: node for node, name in enumerate(names)}
+        self.offsets = offsets
+        self.targets = targets
+
+    @classmethod
+    def from_edges(cls, names: List[str], edges: Iterable[Tuple[int, int]]) -> "CallGraph":
+        """Build a call graph from interned ``(caller, callee)`` id pairs.
+
+        Duplicate edges are removed and every row is sorted by callee id.
+
+        Args:
+            names (List[str]): Function name of each node id
+            edges (Iterable[Tuple[int, int]]): Edges as pairs of node ids
+
+        Returns:
+            CallGraph: The resulting graph
+        """
+        num_nodes = len(names)
+        unique_edges = sorted(set(edges))
+
+        offsets = array("q", [0]) * (num_nodes + 1)
+        for caller, _ in unique_edges:
+            offsets[caller + 1] += 1
+        for node in range(num_nodes):
+            offsets[node + 1] += offsets[node]
+
+        targets = array("q", (callee for _, callee in unique_edges))
+        return cls(names, offsets, targets)
+
+    @classmethod
+    def from_calls(cls, calls: Iterable[Dict[str, Any]], functions: Iterable[str] = ()) -> "CallGraph":
+        """Build a call graph from call graph entries as written by the analysis script.
+
+        Each entry contributes an edge from its ``method`` (the caller) to its ``name``
+        (the callee). Entries involving the ``<global>`` pseudo function are skipped.
+
+        Args:
+            calls (Iterable[Dict[str, Any]]): Call graph entries
+            functions (Iterable[str]): Additional function names to include as nodes,
+                e.g. functions that neither call nor are called by anything
+
+        Returns:
+            CallGraph: The resulting graph
+        """
+        ids: Dict[str, int] = {}
+        names: List[str] = []
+
+        def intern(name: str) -> int:
+            node = ids.get(name)
+            if node is None:
+                node = ids[name] = len(names)
+                names.append(name)
+            return node
+
+        for name in functions:
+            if name != "<global>":
+                intern(name)
+
+        edges: List[Tuple[int, int]] = []
+        for call in calls:
+            caller, callee = call.get("method"), call.get("name")
+            if not caller or not callee or caller == "<global>" or callee == "<global>":
+                continue
+            edges.append((intern(caller), intern(callee)))
+
+        return cls.from_edges(names, edges)
+
+    @property
+    def num_nodes(self) -> int:
+        """Number of nodes in the graph."""
+        return len(self.names)
+
+    @property
+    def num_edges(self) -> int:
+        """Number of (deduplicated) edges in the graph."""
+        return len(self.targets)
+
+    def node_id(self, name: str) -> Optional[int]:
+        """Get the node id of a function name.
+
+        Args:
+            name (str): Function name
+
+        Returns:
+            Optional[int]: Node id, or None if the function is not part of the graph
+        """
+        return self.ids.get(name)
+
+    def successors(self, node: int) -> array:
+        """Get the callees of a node.
+
+        Args:
+            node (int): Node id
+
+        Returns:
+            array: Callee node ids
+        """
+        return self.targets[self.offsets[node] : self.offsets[node + 1]]
+
+    def has_edge(self, caller: int, callee: int) -> bool:
+        """Check whether a node calls another node directly.
+
+        Args:
+            caller (int): Node id of the caller
+            callee (int): Node id of the callee
+
+        Returns:
+            bool: True if the edge exists
+        """
+        start, end = self.offsets[caller], self.offsets[caller + 1]
+        position = bisect_left(self.targets, callee, start, end)
+        return position < end and self.targets[position] == callee
+
+    def reverse(self) -> "CallGraph":
+        """Build the graph with every edge reversed, i.e. from callees to their callers.
+
+        Returns:
+            CallGraph: The reversed graph
+        """
+        offsets = array("q", [0]) * (self.num_nodes + 1)
+        for callee in self.targets:
+            offsets[callee + 1] += 1
+        for node in range(self.num_nodes):
+            offsets[node + 1] += offsets[node]
+
+        # Rows are filled in increasing caller order, so each row ends up sorted
+        position = array("q", offsets[:-1])
+        targets = array("q", [0]) * self.num_edges
+        for caller in range(self.num_nodes):
+            for edge in range(self.offsets[caller], self.offsets[caller + 1]):
+                callee = self.targets[edge]
+                targets[position[callee]] = caller
+                position[callee] += 1
+        return CallGraph(self.names, offsets, targets)
+
+    def call_depths(self, roots: Iterable[int]) -> array:
+        """Compute the minimum call depth of every node with a breadth-first search.
+
+        Args:
+            roots (Iterable[int]): Node ids at depth 0
+
+        Returns:
+            array: Minimum number of calls from any root to each node, -1 if unreachable
+        """
+        depth = array("q", [-1]) * self.num_nodes
+        frontier = []
+        for root in roots:
+            if depth[root] == -1:
+                depth[root] = 0
+                frontier.append(root)
+
+        level = 0
+        offsets, targets = self.offsets, self.targets
+        while frontier:
+            level += 1
+            next_frontier = []
+            for node in frontier:
+                for edge in range(offsets[node], offsets[node + 1]):
+                    succ = targets[edge]
+                    if depth[succ] == -1:
+                        depth[succ] = level
+                        next_frontier.append(succ)
+            frontier = next_frontier
+        return depth
+
+    def reverse_postorder(self, root: int) -> List[int]:
+        """Get the nodes reachable from a root in reverse postorder of a depth-first search.
+
+        Args:
+            root (int): Node id to start from
+
+        Returns:
+            List[int]: Reachable node ids, starting with the root
+        """
+        offsets, targets = self.offsets, self.targets
+        visited = bytearray(self.num_nodes)
+        visited[root] = 1
+        postorder: List[int] = []
+        work = [[root, offsets[root]]]
+        while work:
+            frame = work[-1]
+            node, edge = frame
+            if edge < offsets[node + 1]:
+                frame[1] = edge + 1
+                succ = targets[edge]
+                if not visited[succ]:
+                    visited[succ] = 1
+                    work.append([succ, offsets[succ]])
+                continue
+            work.pop()
+            postorder.append(node)
+        postorder.reverse()
+        return postorder
+
+    def dominators(self, root: int, reverse: Optional["CallGraph"] = None) -> array:
+        """Compute the dominator tree of the nodes reachable from a root.
+
+        A node ``d`` dominates ``v`` if every call chain from the root to ``v`` passes
+        through ``d``. Uses the iterative algorithm of Cooper, Harvey and Kennedy.
+
+        Args:
+            root (int): Node id of the entry point
+            reverse (Optional[CallGraph]): Precomputed reverse() of this graph, to share
+                it across several roots
+
+        Returns:
+            array: Immediate dominator of each node; the root is its own immediate
+                dominator and unreachable nodes have -1
+        """
+        if reverse is None:
+            reverse = self.reverse()
+
+        order = self.reverse_postorder(root)
+        position = array("q", [-1]) * self.num_nodes
+        for index, node in enumerate(order):
+            position[node] = index
+
+        idom = array("q", [-1]) * self.num_nodes
+        idom[root] = root
+
+        def intersect(first: int, second: int) -> int:
+            while first != second:
+                while position[first] > position[second]:
+                    first = idom[first]
+                while position[second] > position[first]:
+                    second = idom[second]
+            return first
+
+        changed = True
+        while changed:
+            changed = False
+            for node in order[1:]:
+                new_idom = -1
+                for edge in range(reverse.offsets[node], reverse.offsets[node + 1]):
+                    pred = reverse.targets[edge]
+                    if idom[pred] == -1:
+                        continue
+                    new_idom = pred if new_idom == -1 else intersect(pred, new_idom)
+                if idom[node] != new_idom:
+                    idom[node] = new_idom
+                    changed = True
+        return idom
+
+    def strongly_connected_components(self) -> List[int]:
+        """Compute the strongly connected components with an iterative Tarjan pass.
+
+        Component ids are assigned in reverse topological order of the condensed graph:
+        for every edge ``u -> v`` between different components, ``comp[u] > comp[v]``.
+
+        Returns:
+            List[int]: Component id of each node
+        """
+        num_nodes = self.num_nodes
+        offsets, targets = self.offsets, self.targets
+
+        index = [-1] * num_nodes
+        low = [0] * num_nodes
+        on_stack = [False] * num_nodes
+        comp = [-1] * num_nodes
+        stack: List[int] = []
+        counter = 0
+        num_components = 0
+
+        for root in range(num_nodes):
+            if index[root] != -1:
+                continue
+
+            index[root] = low[root] = counter
+            counter += 1
+            stack.append(root)
+            on_stack[root] = True
+            work = [[root, offsets[root]]]
+
+            while work:
+                frame = work[-1]
+                node, edge = frame
+                if edge < offsets[node + 1]:
+                    frame[1] = edge + 1
+                    succ = targets[edge]
+                    if index[succ] == -1:
+                        index[succ] = low[succ] = counter
+                        counter += 1
+                        stack.append(succ)
+                        on_stack[succ] = True
+                        work.append([succ, offsets[succ]])
+                    elif on_stack[succ] and index[succ] < low[node]:
+                        low[node] = index[succ]
+                    continue
+
+                work.pop()
+                if work:
+                    parent = work[-1][0]
+                    if low[node] < low[parent]:
+                        low[parent] = low[node]
+
+                if low[node] == index[node]:
+                    while True:
+                        member = stack.pop()
+                        on_stack[member] = False
+                        comp[member] = num_components
+                        if member == node:
+                            break
+                    num_components += 1
+
+        return comp
+
+    def recursive_nodes(self, comp: List[int]) -> List[int]:
+        """Get the nodes that are part of a recursion cycle.
+
+        A node is recursive if it calls itself directly or shares its strongly
+        connected component with another node (mutual recursion).
+
+        Args:
+            comp (List[int]): Component id of each node, as returned by
+                strongly_connected_components()
+
+        Returns:
+            List[int]: Ids of the recursive nodes in increasing order
+        """
+        sizes = [0] * (max(comp) + 1 if comp else 0)
+        for component in comp:
+            sizes[component] += 1
+        return [node for node in range(self.num_nodes) if sizes[comp[node]] > 1 or self.has_edge(node, node)]
+
+    def condense(self, comp: List[int]) -> "CallGraph":
+        """Build the condensed DAG whose nodes are the strongly connected components.
+
+        Args:
+            comp (List[int]): Component id of each node, as returned by
+                strongly_connected_components()
+
+        Returns:
+            CallGraph: The condensed graph; node ``c`` is named after the smallest
+                function name in component ``c``
+        """
+        num_components = max(comp) + 1 if comp else 0
+        labels: List[Optional[str]] = [None] * num_components
+        for node, component in enumerate(comp):
+            label = labels[component]
+            if label is None or self.names[node] < label:
+                labels[component] = self.names[node]
+
+        offsets, targets = self.offsets, self.targets
+        edges = [
+            (comp[node], comp[targets[edge]])
+            for node in range(self.num_nodes)
+            for edge in range(offsets[node], offsets[node + 1])
+            if comp[node] != comp[targets[edge]]
+        ]
+        return CallGraph.from_edges([label or "" for label in labels], edges)
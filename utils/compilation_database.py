@@ -0,0 +1,158 @@
+"""Compilation Database Module
+
+This module prepares a compile_commands.json shipped with the analyzed code for
+c2cpg, so that only the translation units that are actually compiled are parsed,
+with their include paths and defines.
+
+The paths in a compilation database are absolute paths on the machine it was
+generated on. They are mapped into the container:
+- The source root on that machine is found by matching the translation units
+  against the files of the analyzed code
+- File and include paths under the source root are mapped to the container path of
+  the analyzed code; include paths outside of it (e.g. system or build directories)
+  are dropped
+- Translation units that are not part of the analyzed code are dropped
+
+Only the flags that affect parsing are kept (-I, -isystem, -iquote, -D, -U,
+-include and -std), deduplicated and in a canonical order, so that units compiled
+with the same flags share an identical flag set. Of the -D and -U flags of a macro,
+only the last one is kept, as it is the one in effect, and so is the last -std. A
+file listed more than once (e.g. for several build configurations) is parsed once,
+with its first flags.
+"""
+
+import posixpath
+import shlex
+from collections import Counter
+from pathlib import Path, PurePosixPath
+from typing import Any, Dict, List, Optional, Tuple
+
+# Flags taking a path argument, attached ("-Idir") or separate ("-I dir")
+PATH_FLAGS = ("-isystem", "-iquote", "-include", "-I")
+
+# Flags taking a macro argument, attached or separate
+MACRO_FLAGS = ("-D", "-U")
+
+
+def _arguments(entry: Dict[str, Any]) -> List[str]:
+    """Get the compiler arguments of an entry, from "arguments" or "command"."""
+    if "arguments" in entry:
+        return [str(argument) for argument in entry["arguments"]]
+    return shlex.split(str(entry.get("command", "")))
+
+
+def _split_flags(arguments: List[str]) -> List[Tuple[str, str]]:
+    """Get the flags that affect parsing as (flag, value) pairs."""
+    flags = []
+    index = 1
+    while index < len(arguments):
+        argument = arguments[index]
+        index += 1
+        for flag in PATH_FLAGS + MACRO_FLAGS:
+            if argument == flag and index < len(arguments):
+                flags.append((flag, arguments[index]))
+                index += 1
+                break
+            if argument.startswith(flag) and argument != flag:
+                flags.append((flag, argument[len(flag) :]))
+                break
+        else:
+            if argument.startswith("-std="):
+                flags.append(("-std=", argument[len("-std=") :]))
+    return flags
+
+
+def _join(directory: PurePosixPath, path: str) -> PurePosixPath:
+    """Resolve a path relative to a directory, removing "." and ".." components."""
+    return PurePosixPath(posixpath.normpath(str(directory / path)))
+
+
+def _find_source_root(code_path: Path, files: List[PurePosixPath]) -> Optional[PurePosixPath]:
+    """Find the directory on the generating machine that corresponds to the code path.
+
+    For every translation unit, the longest path suffix that exists in the code path
+    gives a candidate root; the most common candidate wins.
+    """
+    roots: Counter = Counter()
+    for file in files:
+        for start in range(1, len(file.parts)):
+            if (code_path / Path(*file.parts[start:])).is_file():
+                roots[PurePosixPath(*file.parts[:start])] += 1
+                break
+    return roots.most_common(1)[0][0] if roots else None
+
+
+def prepare_compilation_database(
+    code_path: Path, database: List[Dict[str, Any]], container_root: str
+) -> Tuple[List[Dict[str, Any]], Dict[str, int]]:
+    """Map a compilation database into the container and normalize its flags.
+
+    Args:
+        code_path (Path): The analyzed code on the host
+        database (List[Dict[str, Any]]): Entries of compile_commands.json, each with
+            "directory", "file" and "arguments" or "command"
+        container_root (str): Container path of the analyzed code
+
+    Returns:
+        Tuple[List[Dict[str, Any]], Dict[str, int]]: The entries for c2cpg, and the
+            number of "entries", "translation_units", "duplicates", "missing" (not
+            part of the analyzed code) and distinct "flag_sets"
+    """
+    resolved = []
+    for entry in database:
+        if not isinstance(entry, dict):
+            continue
+        directory = PurePosixPath(str(entry.get("directory", "/")))
+        resolved.append((directory, _join(directory, str(entry.get("file", ""))), entry))
+
+    root = _find_source_root(code_path, [file for _, file, _ in resolved])
+    container = PurePosixPath(container_root)
+
+    def to_container(path: PurePosixPath) -> Optional[PurePosixPath]:
+        if root is None:
+            return None
+        try:
+            return container / path.relative_to(root)
+        except ValueError:
+            return None
+
+    entries: List[Dict[str, Any]] = []
+    seen = set()
+    flag_sets = set()
+    stats = {"entries": len(database), "translation_units": 0, "duplicates": 0, "missing": 0, "flag_sets": 0}
+    for directory, file, entry in resolved:
+        mapped_file = to_container(file)
+        if mapped_file is None or not (code_path / mapped_file.relative_to(container)).is_file():
+            stats["missing"] += 1
+            continue
+        if mapped_file in seen:
+            stats["duplicates"] += 1
+            continue
+        seen.add(mapped_file)
+
+        flags = []
+        for flag, value in _split_flags(_arguments(entry)):
+            if flag in PATH_FLAGS:
+                mapped_path = to_container(_join(directory, value))
+                if mapped_path is None:
+                    continue
+                value = str(mapped_path)
+            flags.append((flag, value))
+        # Canonical order: include paths keep their search order, macros are sorted by
+        # name and -std comes last. The last -D or -U of a macro and the last -std win
+        # like in the compiler, so only those are kept.
+        paths = [pair for pair in flags if pair[0] in PATH_FLAGS]
+        last: Dict[Tuple[bool, str], Tuple[str, str]] = {}
+        for flag, value in flags:
+            if flag not in PATH_FLAGS:
+                last[(flag == "-std=", value.split("=", 1)[0] if flag in MACRO_FLAGS else "")] = (flag, value)
+        others = [last[key] for key in sorted(last)]
+        canonical = tuple(dict.fromkeys(paths)) + tuple(others)
+        flag_sets.add(canonical)
+
+        arguments = ["cc", *(f"{flag}{value}" for flag, value in canonical), "-c", str(mapped_file)]
+        entries.append({"directory": container_root, "file": str(mapped_file), "arguments": arguments})
+
+    stats["translation_units"] = len(entries)
+    stats["flag_sets"] = len(flag_sets)
+    return entries, stats
@@ -5,6 +5,8 @@ from os import PathLike
 
 from loguru import logger
 from settings import DOCKER_SETTINGS
+from utils.job_scheduler import Allocation, format_cpu_list
+from utils.tracing import SPAN_KIND_CLIENT, TRACEPARENT_ENV, TRACER
 
 
 class DockerManager:
@@ -29,6 +31,8 @@ class DockerManager:
         volumes: Dict[str, Dict[str, str]],
         environment: Dict[str, str],
         working_dir: str = "/app",
+        allocation: Optional[Allocation] = None,
+        tmpfs: Optional[Dict[str, str]] = None,
     ) -> bool:
         """Start a Docker container with the specified configuration.
 
@@ -38,6 +42,8 @@ class DockerManager:
             volumes: Dictionary mapping host paths to container paths with mode
             environment: Dictionary of environment variables
             working_dir: Working directory inside the container
+            allocation: CPUs and memory to limit the container to, unlimited if None
+            tmpfs: Dictionary mapping container paths to the mount options of a tmpfs
 
         Returns:
             bool: True if container started successfully, False otherwise
@@ -71,6 +77,9 @@ class DockerManager:
             # Build the Docker run command
             cmd: List[str] = [str(self.docker_cmd), "run", "--rm", "-d", "--platform", self.platform, "-w", working_dir]
 
+            if allocation:
+                cmd.extend(self._limit_args(allocation))
+
             # Add environment variables
             for key, value in environment.items():
                 cmd.extend(["-e", f"{key}={value}"])
@@ -80,6 +89,10 @@ class DockerManager:
                 host_path_str = str(host_path) if isinstance(host_path, (Path, PathLike)) else host_path
                 cmd.extend(["-v", f"{host_path_str}:{mount_info['bind']}:{mount_info['mode']}"])
 
+            # Add tmpfs mounts
+            for container_path, options in (tmpfs or {}).items():
+                cmd.extend(["--tmpfs", f"{container_path}:{options}"])
+
             # Add image and command
             cmd.extend([image] + command)
 
@@ -106,6 +119,49 @@ class DockerManager:
             logger.error(f"Unexpected error starting container: {str(e)}")
             return False
 
+    @staticmethod
+    def _limit_args(allocation: Allocation) -> List[str]:
+        """Get the docker run arguments limiting the container to an allocation.
+
+        Swap is disabled by setting the swap limit to the memory limit, so that a job
+        that outgrows its estimate fails instead of slowing down the host.
+
+        Args:
+            allocation: The CPUs and memory of the job
+
+        Returns:
+            List[str]: The arguments
+        """
+        memory = f"{allocation.memory_mb}m"
+        args = ["--cpus", str(len(allocation.cpus)), "--memory", memory, "--memory-swap", memory]
+        if DOCKER_SETTINGS["limits"]["pin_cpus"]:
+            args += ["--cpuset-cpus", format_cpu_list(allocation.cpus), "--cpuset-mems", str(allocation.node)]
+        return args
+
+    def update_limits(self, allocation: Allocation) -> bool:
+        """Change the limits of the running container to a new allocation.
+
+        Args:
+            allocation: The CPUs and memory of the next job
+
+        Returns:
+            bool: True if the limits were updated, False otherwise
+        """
+        if not self.container_id:
+            logger.warning("No container ID available to update")
+            return False
+
+        result = subprocess.run(
+            [str(self.docker_cmd), "update", *self._limit_args(allocation), self.container_id],
+            stdout=subprocess.PIPE,
+            stderr=subprocess.PIPE,
+            text=True,
+        )
+        if result.returncode != 0:
+            logger.error(f"Error updating container limits: {result.stderr}")
+            return False
+        return True
+
     def stop_container(self) -> bool:
         """Stop the running container.
 
@@ -142,6 +198,9 @@ class DockerManager:
     ) -> Tuple[bool, str, str]:
         """Execute a command in the running container.
 
+        The command is traced as a span, and the trace context of the span is passed
+        to the command in the TRACEPARENT environment variable.
+
         Args:
             command: List of command arguments to execute
             timeout: Command timeout in seconds
@@ -153,27 +212,61 @@ class DockerManager:
         if not self.container_id:
             return False, "", "No container running"
 
-        cmd: List[str] = [str(self.docker_cmd), "exec", self.container_id] + list(command)
-        logger.debug(f"Executing command in container: {' '.join(cmd)}")
+        command = list(command)
+        with TRACER.span(
+            "docker.exec", kind=SPAN_KIND_CLIENT, attributes={"process.executable.name": command[0]}
+        ) as span:
+            cmd: List[str] = [str(self.docker_cmd), "exec", "-e", f"{TRACEPARENT_ENV}={span.traceparent()}"]
+            cmd += [self.container_id] + command
+            logger.debug(f"Executing command in container: {' '.join(cmd)}")
 
-        try:
-            result = subprocess.run(
-                cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True, timeout=timeout, input=input
-            )
+            try:
+                result = subprocess.run(
+                    cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True, timeout=timeout, input=input
+                )
 
-            if result.stdout:
-                logger.debug(f"Command stdout: {result.stdout}")
-            if result.stderr:
-                logger.error(f"Command stderr: {result.stderr}")
+                if result.stdout:
+                    logger.debug(f"Command stdout: {result.stdout}")
+                if result.stderr:
+                    logger.error(f"Command stderr: {result.stderr}")
 
-            return result.returncode == 0, result.stdout, result.stderr
+                span.set_attribute("process.exit.code", result.returncode)
+                if result.returncode != 0:
+                    span.set_error(f"Exit code {result.returncode}")
+                return result.returncode == 0, result.stdout, result.stderr
 
-        except subprocess.TimeoutExpired:
-            logger.error(f"Command timed out after {timeout} seconds")
-            return False, "", "Command timed out"
-        except Exception as e:
-            logger.exception(f"Error executing command: {str(e)}")
-            return False, "", str(e)
+            except subprocess.TimeoutExpired:
+                logger.error(f"Command timed out after {timeout} seconds")
+                span.set_error("Command timed out")
+                return False, "", "Command timed out"
+            except Exception as e:
+                logger.exception(f"Error executing command: {str(e)}")
+                span.set_error(str(e))
+                return False, "", str(e)
+
+    def read_cgroup_stats(self, script: str, timeout: int = 10) -> Optional[str]:
+        """Read the cgroup counters of the running container.
+
+        Unlike execute_command(), this is neither traced nor logged, since it is called
+        periodically while other commands run.
+
+        Args:
+            script: Shell script printing the cgroup files
+            timeout: Command timeout in seconds
+
+        Returns:
+            Optional[str]: Output of the script, or None if it failed
+        """
+        if not self.container_id:
+            return None
+
+        cmd: List[str] = [str(self.docker_cmd), "exec", self.container_id, "sh", "-c", script]
+        try:
+            result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True, timeout=timeout)
+            return result.stdout
+        except (subprocess.TimeoutExpired, OSError) as e:
+            logger.debug(f"Failed to read cgroup counters: {str(e)}")
+            return None
 
     def _verify_container_running(self) -> bool:
         """Verify that the container is running.
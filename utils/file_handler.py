@@ -1,6 +1,6 @@
 import json
 from pathlib import Path
-from typing import Any, Dict, List
+from typing import Any, Dict, Iterable, Iterator, List
 
 from loguru import logger
 
@@ -27,6 +27,67 @@ class FileHandler:
             logger.error(f"Error writing JSON file {file_path}: {str(e)}")
             return False
 
+    @staticmethod
+    def iter_json_array(file_path: Path, chunk_size: int = 1 << 16) -> Iterator[Any]:
+        """Parse the elements of a JSON array file one by one, without loading the whole file.
+
+        Raises:
+            ValueError: If the file is not a JSON array
+        """
+        decoder = json.JSONDecoder()
+        with open(file_path, "r") as f:
+            buffer, eof = "", False
+
+            def read_more() -> None:
+                nonlocal buffer, eof
+                # Grow with the buffer, so that large elements are not parsed again per chunk
+                chunk = f.read(max(chunk_size, len(buffer)))
+                eof = not chunk
+                buffer += chunk
+
+            read_more()
+            buffer = buffer.lstrip()
+            if not buffer.startswith("["):
+                raise ValueError(f"Not a JSON array: {file_path}")
+            buffer = buffer[1:]
+            while True:
+                buffer = buffer.lstrip()
+                if not buffer:
+                    if eof:
+                        raise ValueError(f"Unterminated JSON array: {file_path}")
+                    read_more()
+                    continue
+                if buffer[0] == "]":
+                    return
+                if buffer[0] == ",":
+                    buffer = buffer[1:]
+                    continue
+                try:
+                    element, end = decoder.raw_decode(buffer)
+                except json.JSONDecodeError:
+                    if eof:
+                        raise
+                    read_more()
+                    continue
+                # A number at the end of the buffer may continue in the next chunk
+                if end == len(buffer) and not eof:
+                    read_more()
+                    continue
+                yield element
+                buffer = buffer[end:]
+
+    @staticmethod
+    def append_json_line(data: Any, file_path: Path) -> bool:
+        """Append data to a JSON Lines file as a single line."""
+        try:
+            file_path.parent.mkdir(parents=True, exist_ok=True)
+            with open(file_path, "a") as f:
+                f.write(json.dumps(data, separators=(",", ":")) + "\n")
+            return True
+        except Exception as e:
+            logger.error(f"Error appending to JSON Lines file {file_path}: {str(e)}")
+            return False
+
     @staticmethod
     def read_text(file_path: Path) -> str:
         """Read text content from a file."""
@@ -48,6 +109,17 @@ class FileHandler:
             logger.error(f"Error writing text file {file_path}: {str(e)}")
             return False
 
+    @staticmethod
+    def write_lines(lines: Iterable[str], file_path: Path) -> bool:
+        """Write text content to a file as it is produced, without joining it in memory."""
+        try:
+            with open(file_path, "w") as f:
+                f.writelines(lines)
+            return True
+        except Exception as e:
+            logger.error(f"Error writing text file {file_path}: {str(e)}")
+            return False
+
     @staticmethod
     def find_source_files(directory: Path, extensions: set) -> List[Path]:
         """Find all source files with given extensions in a directory."""
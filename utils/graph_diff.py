@@ -0,0 +1,141 @@
+"""Call Graph Diff Module
+
+This module computes the difference between the call graphs of two analyses.
+
+The functions and call edges of each analysis are split into shards, one per source
+file: a shard holds the functions defined in the file and the call edges whose call
+site is in the file. Every shard has a digest, so shards of files that did not change
+between the analyses are skipped without comparing their contents. Changed shards are
+compared by merging their sorted, interned function and edge lists.
+"""
+
+import hashlib
+import json
+from typing import Any, Dict, Iterable, List, NamedTuple, Tuple
+
+
+class Shard(NamedTuple):
+    """Functions and call edges of one source file.
+
+    Attributes:
+        functions: Sorted, deduplicated function names defined in the file
+        edges: Sorted, deduplicated ``(caller, callee)`` pairs with their call site in the file
+    """
+
+    functions: List[str]
+    edges: List[Tuple[str, str]]
+
+    def digest(self) -> str:
+        """Get a digest of the shard contents.
+
+        Returns:
+            str: Hex digest that is equal for shards with equal contents
+        """
+        return hashlib.sha256(json.dumps([self.functions, self.edges]).encode()).hexdigest()
+
+
+def shard_results(functions: Iterable[Dict[str, Any]], calls: Iterable[Dict[str, Any]]) -> Dict[str, Shard]:
+    """Split cleaned functions and call graph entries into per-file shards.
+
+    Args:
+        functions (Iterable[Dict[str, Any]]): Cleaned function entries
+        calls (Iterable[Dict[str, Any]]): Cleaned call graph entries
+
+    Returns:
+        Dict[str, Shard]: Shard of each source file
+    """
+    shard_functions: Dict[str, set] = {}
+    shard_edges: Dict[str, set] = {}
+    for func in functions:
+        shard_functions.setdefault(func.get("file", "<unknown>"), set()).add(func["name"])
+    for call in calls:
+        if call.get("method") == "<global>" or call.get("name") == "<global>":
+            continue
+        shard_edges.setdefault(call.get("file", "<unknown>"), set()).add((call["method"], call["name"]))
+
+    return {
+        file: Shard(sorted(shard_functions.get(file, ())), sorted(shard_edges.get(file, ())))
+        for file in shard_functions.keys() | shard_edges.keys()
+    }
+
+
+def _merge_difference(old: List[int], new: List[int]) -> Tuple[List[int], List[int]]:
+    """Compare two sorted lists of interned ids in a single merge pass.
+
+    Args:
+        old (List[int]): Sorted, deduplicated ids of the old analysis
+        new (List[int]): Sorted, deduplicated ids of the new analysis
+
+    Returns:
+        Tuple[List[int], List[int]]: Ids only in old (removed) and only in new (added)
+    """
+    removed: List[int] = []
+    added: List[int] = []
+    i = j = 0
+    while i < len(old) and j < len(new):
+        if old[i] == new[j]:
+            i += 1
+            j += 1
+        elif old[i] < new[j]:
+            removed.append(old[i])
+            i += 1
+        else:
+            added.append(new[j])
+            j += 1
+    removed.extend(old[i:])
+    added.extend(new[j:])
+    return removed, added
+
+
+def diff_shards(old_shards: Dict[str, Shard], new_shards: Dict[str, Shard]) -> Dict[str, Any]:
+    """Compute the added and removed functions and call edges between two analyses.
+
+    Functions are identified by file and name, and call edges by the file of their
+    call site, caller and callee. A function that moved to another file is therefore
+    reported as removed from the old and added to the new file.
+
+    Args:
+        old_shards (Dict[str, Shard]): Shards of the old analysis
+        new_shards (Dict[str, Shard]): Shards of the new analysis
+
+    Returns:
+        Dict[str, Any]: The diff with the following keys:
+            - functions: "added" and "removed" functions (name, file)
+            - edges: "added" and "removed" call edges (caller, callee, file)
+            - files: Number of "changed" and "unchanged" files
+    """
+    result: Dict[str, Any] = {
+        "functions": {"added": [], "removed": []},
+        "edges": {"added": [], "removed": []},
+        "files": {"changed": 0, "unchanged": 0},
+    }
+    empty = Shard([], [])
+
+    for file in sorted(old_shards.keys() | new_shards.keys()):
+        old, new = old_shards.get(file, empty), new_shards.get(file, empty)
+        if file in old_shards and file in new_shards and old.digest() == new.digest():
+            result["files"]["unchanged"] += 1
+            continue
+        result["files"]["changed"] += 1
+
+        # Intern the names of both sides in sorted order, so id order matches name order
+        names = sorted(
+            set(old.functions) | set(new.functions) | {name for edge in old.edges + new.edges for name in edge}
+        )
+        ids = {name: node for node, name in enumerate(names)}
+        stride = len(names)
+
+        removed, added = _merge_difference([ids[name] for name in old.functions], [ids[name] for name in new.functions])
+        result["functions"]["removed"].extend({"name": names[node], "file": file} for node in removed)
+        result["functions"]["added"].extend({"name": names[node], "file": file} for node in added)
+
+        removed, added = _merge_difference(
+            [ids[caller] * stride + ids[callee] for caller, callee in old.edges],
+            [ids[caller] * stride + ids[callee] for caller, callee in new.edges],
+        )
+        for key, edges in (("removed", removed), ("added", added)):
+            result["edges"][key].extend(
+                {"caller": names[edge // stride], "callee": names[edge % stride], "file": file} for edge in edges
+            )
+
+    return result
@@ -0,0 +1,124 @@
+"""Graph Export Module
+
+This module exports call graphs to formats understood by graph tools and databases:
+- DOT (Graphviz)
+- GraphML
+- Neo4j ``neo4j-admin database import`` CSV node and relationship files
+
+All exporters are generators over the interned CSR arrays of a CallGraph and yield
+the output line by line, so exports can be streamed to files or HTTP responses
+without building the whole document in memory.
+"""
+
+from typing import AbstractSet, Dict, Iterator
+from xml.sax.saxutils import escape
+
+from utils.call_graph import CallGraph
+
+# Export formats and their MIME types
+EXPORT_FORMATS: Dict[str, str] = {
+    "dot": "text/vnd.graphviz",
+    "graphml": "application/xml",
+    "neo4j_nodes": "text/csv",
+    "neo4j_edges": "text/csv",
+}
+
+
+def _dot_quote(value: str) -> str:
+    """Quote a string as a DOT identifier."""
+    return '"' + value.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def _csv_quote(value: str) -> str:
+    """Quote a string as a CSV field in the dialect expected by neo4j-admin."""
+    return '"' + value.replace('"', '""') + '"'
+
+
+def iter_dot(graph: CallGraph, node_files: Dict[str, str]) -> Iterator[str]:
+    """Export a call graph in DOT format.
+
+    Args:
+        graph (CallGraph): The call graph
+        node_files (Dict[str, str]): File of each function; functions without a
+            file (e.g. system functions) get no file attribute
+
+    Yields:
+        str: Lines of the DOT document
+    """
+    yield "digraph call_graph {\n"
+    for node, name in enumerate(graph.names):
+        file = node_files.get(name)
+        attributes = f"label={_dot_quote(name)}"
+        if file:
+            attributes += f", file={_dot_quote(file)}"
+        yield f"  n{node} [{attributes}];\n"
+    for node in range(graph.num_nodes):
+        for edge in range(graph.offsets[node], graph.offsets[node + 1]):
+            yield f"  n{node} -> n{graph.targets[edge]};\n"
+    yield "}\n"
+
+
+def iter_graphml(graph: CallGraph, node_files: Dict[str, str]) -> Iterator[str]:
+    """Export a call graph in GraphML format.
+
+    Args:
+        graph (CallGraph): The call graph
+        node_files (Dict[str, str]): File of each function; functions without a
+            file (e.g. system functions) get no file attribute
+
+    Yields:
+        str: Lines of the GraphML document
+    """
+    yield '<?xml version="1.0" encoding="UTF-8"?>\n'
+    yield '<graphml xmlns="http://graphml.graphdrawing.org/xmlns">\n'
+    yield '  <key id="name" for="node" attr.name="name" attr.type="string"/>\n'
+    yield '  <key id="file" for="node" attr.name="file" attr.type="string"/>\n'
+    yield '  <graph id="call_graph" edgedefault="directed">\n'
+    for node, name in enumerate(graph.names):
+        file = node_files.get(name)
+        file_data = f'<data key="file">{escape(file)}</data>' if file else ""
+        yield f'    <node id="n{node}"><data key="name">{escape(name)}</data>{file_data}</node>\n'
+    for node in range(graph.num_nodes):
+        for edge in range(graph.offsets[node], graph.offsets[node + 1]):
+            yield f'    <edge source="n{node}" target="n{graph.targets[edge]}"/>\n'
+    yield "  </graph>\n"
+    yield "</graphml>\n"
+
+
+def iter_neo4j_nodes(
+    graph: CallGraph, node_files: Dict[str, str], system_functions: AbstractSet[str] = frozenset(), id_prefix: str = ""
+) -> Iterator[str]:
+    """Export the functions of a call graph as a neo4j-admin node CSV file.
+
+    Args:
+        graph (CallGraph): The call graph
+        node_files (Dict[str, str]): File of each function
+        system_functions (AbstractSet[str]): Names of system functions, flagged in the system column
+        id_prefix (str): Prefix for node ids, e.g. the code ID, so that the call graphs
+            of several analyses can be imported into the same database
+
+    Yields:
+        str: Lines of the CSV file
+    """
+    yield "id:ID(Function),name,file,system:boolean,:LABEL\n"
+    for node, name in enumerate(graph.names):
+        system = "true" if name in system_functions else "false"
+        file = _csv_quote(node_files.get(name, ""))
+        yield f"{_csv_quote(f'{id_prefix}{node}')},{_csv_quote(name)},{file},{system},Function\n"
+
+
+def iter_neo4j_edges(graph: CallGraph, id_prefix: str = "") -> Iterator[str]:
+    """Export the calls of a call graph as a neo4j-admin relationship CSV file.
+
+    Args:
+        graph (CallGraph): The call graph
+        id_prefix (str): Prefix for node ids, must match the one of the node file
+
+    Yields:
+        str: Lines of the CSV file
+    """
+    yield ":START_ID(Function),:END_ID(Function),:TYPE\n"
+    for node in range(graph.num_nodes):
+        start = _csv_quote(f"{id_prefix}{node}")
+        for edge in range(graph.offsets[node], graph.offsets[node + 1]):
+            yield f"{start},{_csv_quote(f'{id_prefix}{graph.targets[edge]}')},CALLS\n"
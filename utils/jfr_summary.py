@@ -0,0 +1,133 @@
+"""JFR Summary Module
+
+This module summarizes Java Flight Recorder recordings of the Joern JVMs.
+
+Recordings are converted to JSON with the JDK ``jfr print --json`` tool inside the
+Joern container (see JFR_PRINT_EVENTS), and summarized here into:
+- GC pause totals, overall and per collector
+- Peak heap usage
+- Allocation hot spots, i.e. the allocated classes and allocating frames with the
+  largest sampled allocation weight
+- Top CPU frames, i.e. the methods most often on top of the stack in execution samples
+"""
+
+import re
+from collections import Counter
+from typing import Any, Dict, Iterable, List, Optional
+
+# Events passed to ``jfr print --events``
+JFR_PRINT_EVENTS = ["jdk.GarbageCollection", "jdk.GCHeapSummary", "jdk.ObjectAllocationSample", "jdk.ExecutionSample"]
+
+# Number of entries in the hot spot and top frame lists
+TOP_ENTRIES = 20
+
+_DURATION_PATTERN = re.compile(r"^PT(?:(?P<h>[\d.]+)H)?(?:(?P<m>[\d.]+)M)?(?:(?P<s>-?[\d.]+)S)?$")
+
+
+def _duration_seconds(value: Any) -> float:
+    """Convert a JFR duration to seconds.
+
+    ``jfr print --json`` writes durations as ISO-8601 strings, e.g. ``PT0.0123S``.
+    """
+    if isinstance(value, (int, float)):
+        return float(value) / 1e9
+    match = _DURATION_PATTERN.match(str(value))
+    if not match:
+        return 0.0
+    hours, minutes, seconds = (float(match.group(group) or 0) for group in ("h", "m", "s"))
+    return hours * 3600 + minutes * 60 + seconds
+
+
+def _class_name(value: Any) -> str:
+    """Get the dotted name of a JFR class value."""
+    name = value.get("name", "") if isinstance(value, dict) else str(value or "")
+    return str(name).replace("/", ".")
+
+
+def _top_frame(stack_trace: Any) -> Optional[str]:
+    """Get the ``Class.method`` of the top frame of a JFR stack trace."""
+    if not isinstance(stack_trace, dict) or not stack_trace.get("frames"):
+        return None
+    method = stack_trace["frames"][0].get("method") or {}
+    return f"{_class_name(method.get('type'))}.{method.get('name', '?')}"
+
+
+def summarize_events(events: Iterable[Dict[str, Any]]) -> Dict[str, Any]:
+    """Summarize the events of a JFR recording.
+
+    Args:
+        events (Iterable[Dict[str, Any]]): Events as written by ``jfr print --json``,
+            each with "type" and "values"
+
+    Returns:
+        Dict[str, Any]: Summary with:
+            - gc: Number of collections, total and maximum pause, and pauses per collector
+            - heap: Peak used heap in bytes
+            - allocation_hot_spots: Allocated class and allocating frame with sampled bytes
+            - cpu_top_frames: Top frames with their number and fraction of samples
+    """
+    collections = 0
+    total_pause = 0.0
+    max_pause = 0.0
+    pauses_by_collector: Dict[str, Dict[str, Any]] = {}
+    peak_heap = 0
+    allocations: Counter[tuple] = Counter()
+    samples: Counter[str] = Counter()
+
+    for event in events:
+        event_type = event.get("type")
+        values = event.get("values") or {}
+        if event_type == "jdk.GarbageCollection":
+            pause = _duration_seconds(values.get("sumOfPauses", 0))
+            collections += 1
+            total_pause += pause
+            max_pause = max(max_pause, pause)
+            collector = pauses_by_collector.setdefault(str(values.get("name", "unknown")), {"count": 0, "pause": 0.0})
+            collector["count"] += 1
+            collector["pause"] += pause
+        elif event_type == "jdk.GCHeapSummary":
+            peak_heap = max(peak_heap, int(values.get("heapUsed") or 0))
+        elif event_type == "jdk.ObjectAllocationSample":
+            key = (_class_name(values.get("objectClass")), _top_frame(values.get("stackTrace")) or "<unknown>")
+            allocations[key] += int(values.get("weight") or 0)
+        elif event_type == "jdk.ExecutionSample":
+            frame = _top_frame(values.get("stackTrace"))
+            if frame:
+                samples[frame] += 1
+
+    total_samples = sum(samples.values())
+    return {
+        "gc": {
+            "collections": collections,
+            "total_pause_seconds": total_pause,
+            "max_pause_seconds": max_pause,
+            "by_collector": {
+                name: {"collections": stats["count"], "total_pause_seconds": stats["pause"]}
+                for name, stats in sorted(pauses_by_collector.items())
+            },
+        },
+        "heap": {"peak_used_bytes": peak_heap},
+        "allocation_hot_spots": [
+            {"class": class_name, "frame": frame, "sampled_bytes": weight}
+            for (class_name, frame), weight in allocations.most_common(TOP_ENTRIES)
+        ],
+        "cpu_top_frames": [
+            {"frame": frame, "samples": count, "fraction": count / total_samples}
+            for frame, count in samples.most_common(TOP_ENTRIES)
+        ],
+    }
+
+
+def summarize_recording(recording: Any) -> Dict[str, Any]:
+    """Summarize the output of ``jfr print --json`` for one recording.
+
+    Args:
+        recording (Any): The parsed JSON document, ``{"recording": {"events": [...]}}``
+
+    Returns:
+        Dict[str, Any]: The summary, see summarize_events()
+    """
+    events: List[Dict[str, Any]] = []
+    if isinstance(recording, dict):
+        events = (recording.get("recording") or {}).get("events") or []
+    return summarize_events(events)
@@ -0,0 +1,256 @@
+"""Job Scheduler Module
+
+This module sizes the Joern container of each analysis job and packs the jobs onto
+the host, so that concurrent JVMs do not compete for every core and the memory.
+
+- The CPUs, memory and scratch space of a job are estimated from the size of its
+  source files, within the bounds of the limits and the scratch settings in
+  DOCKER_SETTINGS
+- The host is modeled as its NUMA nodes, each with the CPUs the process may use and
+  its share of the memory; without NUMA information the host is a single node
+- A job is placed on the node with the fewest free CPUs that still fits it (best
+  fit), so that large jobs find a free node, and pinned to free CPUs of that node
+  and to its memory
+- Jobs that do not fit wait until running jobs release their resources
+
+A job larger than any node is shrunk to the largest node, so that it can run at all.
+
+The jobs are packed per process; several analyzer or API processes on one host do
+not coordinate, so pinning (pin_cpus in DOCKER_SETTINGS) is off by default.
+"""
+
+import math
+import os
+import re
+import threading
+from pathlib import Path
+from typing import Iterable, List, NamedTuple, Optional, Set
+
+from loguru import logger
+
+from settings import DOCKER_SETTINGS, ContainerLimitSettings, ScratchSettings
+
+MIB = 1024 * 1024
+
+# Sysfs directory with the NUMA nodes of the host
+NODE_PATH = Path("/sys/devices/system/node")
+
+
+class JobResources(NamedTuple):
+    """Estimated resources of an analysis job."""
+
+    cpus: int
+    memory_mb: int
+
+
+class Allocation(NamedTuple):
+    """Resources reserved for a running job.
+
+    Attributes:
+        node: NUMA node the job runs on
+        cpus: Host CPU ids the job is pinned to
+        memory_mb: Memory limit of the container (MiB)
+    """
+
+    node: int
+    cpus: List[int]
+    memory_mb: int
+
+
+class _Node:
+    """Free resources of a NUMA node."""
+
+    def __init__(self, node_id: int, cpus: Iterable[int], memory_mb: int):
+        self.node_id = node_id
+        self.cpus = sorted(cpus)
+        self.free_cpus: Set[int] = set(self.cpus)
+        self.memory_mb = memory_mb
+        self.free_memory_mb = memory_mb
+
+    def fits(self, resources: JobResources) -> bool:
+        return len(self.free_cpus) >= resources.cpus and self.free_memory_mb >= resources.memory_mb
+
+
+def parse_cpu_list(cpu_list: str) -> List[int]:
+    """Parse a Linux CPU list like "0-3,8,10-11".
+
+    Args:
+        cpu_list (str): The CPU list
+
+    Returns:
+        List[int]: The CPU ids
+    """
+    cpus: List[int] = []
+    for part in cpu_list.strip().split(","):
+        if "-" in part:
+            first, last = part.split("-", 1)
+            cpus.extend(range(int(first), int(last) + 1))
+        elif part:
+            cpus.append(int(part))
+    return cpus
+
+
+def format_cpu_list(cpus: Iterable[int]) -> str:
+    """Format CPU ids as a Linux CPU list, as expected by --cpuset-cpus.
+
+    Args:
+        cpus (Iterable[int]): The CPU ids
+
+    Returns:
+        str: The CPU list, with consecutive ids as ranges
+    """
+    ranges: List[List[int]] = []
+    for cpu in sorted(set(cpus)):
+        if ranges and cpu == ranges[-1][1] + 1:
+            ranges[-1][1] = cpu
+        else:
+            ranges.append([cpu, cpu])
+    return ",".join(str(first) if first == last else f"{first}-{last}" for first, last in ranges)
+
+
+def estimate_job_resources(source_bytes: int, limits: ContainerLimitSettings) -> JobResources:
+    """Estimate the CPUs and memory of a job from the size of its source files.
+
+    Args:
+        source_bytes (int): Total size of the analyzed source files
+        limits (ContainerLimitSettings): Bounds and rates of the estimate
+
+    Returns:
+        JobResources: The estimated resources
+    """
+    cpus = math.ceil(source_bytes / limits["source_bytes_per_cpu"])
+    memory_mb = limits["min_memory_mb"] + math.ceil(source_bytes / MIB * limits["memory_per_source_mb"])
+    return JobResources(
+        cpus=min(max(cpus, limits["min_cpus"]), limits["max_cpus"]),
+        memory_mb=min(memory_mb, limits["max_memory_mb"]),
+    )
+
+
+def estimate_scratch_mb(source_bytes: int, scratch: ScratchSettings) -> int:
+    """Estimate the size of the scratch space of a job from the size of its source files.
+
+    Args:
+        source_bytes (int): Total size of the analyzed source files
+        scratch (ScratchSettings): Bounds and rate of the estimate
+
+    Returns:
+        int: The size in MiB, 0 if the scratch space is disabled
+    """
+    if not scratch["enabled"]:
+        return 0
+    size_mb = math.ceil(source_bytes / MIB * scratch["size_per_source_mb"])
+    return min(max(size_mb, scratch["min_size_mb"]), scratch["max_size_mb"])
+
+
+def _host_memory_mb() -> int:
+    """Get the physical memory of the host (MiB)."""
+    return os.sysconf("SC_PAGE_SIZE") * os.sysconf("SC_PHYS_PAGES") // MIB
+
+
+def _available_cpus() -> Set[int]:
+    """Get the CPUs the process may run on."""
+    if hasattr(os, "sched_getaffinity"):
+        return set(os.sched_getaffinity(0))
+    return set(range(os.cpu_count() or 1))
+
+
+def discover_nodes(memory_fraction: float) -> List[_Node]:
+    """Get the NUMA nodes of the host with their usable CPUs and memory.
+
+    Args:
+        memory_fraction (float): Share of the memory of each node available to jobs
+
+    Returns:
+        List[_Node]: The nodes with at least one usable CPU
+    """
+    available = _available_cpus()
+    nodes = []
+    for node_dir in sorted(NODE_PATH.glob("node[0-9]*")):
+        try:
+            cpus = set(parse_cpu_list((node_dir / "cpulist").read_text())) & available
+            meminfo = (node_dir / "meminfo").read_text()
+        except (OSError, ValueError):
+            continue
+        match = re.search(r"MemTotal:\s+(\d+) kB", meminfo)
+        if cpus and match:
+            memory_mb = int(int(match.group(1)) / 1024 * memory_fraction)
+            nodes.append(_Node(int(node_dir.name[len("node") :]), cpus, memory_mb))
+    if not nodes:
+        nodes = [_Node(0, available, int(_host_memory_mb() * memory_fraction))]
+    return nodes
+
+
+class JobScheduler:
+    """Packs analysis jobs onto the CPUs and memory of the host.
+
+    Attributes:
+        nodes (List[_Node]): NUMA nodes of the host with their free resources
+    """
+
+    def __init__(self, nodes: Optional[List[_Node]] = None):
+        """Initialize the scheduler.
+
+        Args:
+            nodes (Optional[List[_Node]]): Nodes to schedule on; discovered on first use
+                if not given
+        """
+        self._nodes = nodes
+        self._condition = threading.Condition()
+
+    @property
+    def nodes(self) -> List[_Node]:
+        if self._nodes is None:
+            self._nodes = discover_nodes(DOCKER_SETTINGS["limits"]["host_memory_fraction"])
+            logger.debug(f"Scheduling jobs on {len(self._nodes)} NUMA nodes")
+        return self._nodes
+
+    def fit(self, resources: JobResources) -> JobResources:
+        """Shrink the resources of a job to the largest node.
+
+        Args:
+            resources (JobResources): The requested resources
+
+        Returns:
+            JobResources: The resources the job can get
+        """
+        largest = max(self.nodes, key=lambda node: (len(node.cpus), node.memory_mb))
+        return JobResources(
+            cpus=min(resources.cpus, len(largest.cpus)), memory_mb=min(resources.memory_mb, largest.memory_mb)
+        )
+
+    def acquire(self, resources: JobResources) -> Allocation:
+        """Reserve resources for a job, waiting until a node has them free.
+
+        Args:
+            resources (JobResources): The resources of the job, see fit()
+
+        Returns:
+            Allocation: The reserved CPUs and memory, to be released with release()
+        """
+        with self._condition:
+            while True:
+                candidates = [node for node in self.nodes if node.fits(resources)]
+                if candidates:
+                    break
+                self._condition.wait()
+            node = min(candidates, key=lambda node: (len(node.free_cpus), node.free_memory_mb, node.node_id))
+            cpus = sorted(node.free_cpus)[: resources.cpus]
+            node.free_cpus.difference_update(cpus)
+            node.free_memory_mb -= resources.memory_mb
+            return Allocation(node=node.node_id, cpus=cpus, memory_mb=resources.memory_mb)
+
+    def release(self, allocation: Allocation) -> None:
+        """Release the resources of a finished job.
+
+        Args:
+            allocation (Allocation): The allocation returned by acquire()
+        """
+        with self._condition:
+            for node in self.nodes:
+                if node.node_id == allocation.node:
+                    node.free_cpus.update(allocation.cpus)
+                    node.free_memory_mb += allocation.memory_mb
+            self._condition.notify_all()
+
+
+SCHEDULER = JobScheduler()
@@ -0,0 +1,312 @@
+"""Metrics Module
+
+This module provides phase timing and resource metrics for analysis runs.
+
+Metrics are collected in a process-wide registry and rendered in the Prometheus text
+exposition format. Each analysis run additionally keeps its own RunTimings, which
+feed the registry and can be saved as timings.json next to the results.
+"""
+
+import resource
+import sys
+import threading
+import time
+from contextlib import contextmanager
+from pathlib import Path
+from typing import Dict, Iterator, List, Optional, Sequence, Tuple
+
+from utils.file_handler import FileHandler
+from utils.tracing import TRACER
+
+# Histogram buckets for durations in seconds
+DURATION_BUCKETS: Tuple[float, ...] = (0.01, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 120, 300, 600)
+
+# Histogram buckets for sizes in bytes, from 1 KiB to 4 GiB
+SIZE_BUCKETS: Tuple[float, ...] = tuple(float(4**exponent * 1024) for exponent in range(12))
+
+# Histogram buckets for item counts (functions, calls, ...)
+COUNT_BUCKETS: Tuple[float, ...] = tuple(float(10**exponent) for exponent in range(8))
+
+Labels = Tuple[Tuple[str, str], ...]
+
+
+class _Histogram:
+    """Cumulative histogram of observed values."""
+
+    def __init__(self, buckets: Sequence[float]):
+        self.buckets = tuple(buckets)
+        self.counts = [0] * len(self.buckets)
+        self.count = 0
+        self.sum = 0.0
+
+    def observe(self, value: float) -> None:
+        for index, bound in enumerate(self.buckets):
+            if value <= bound:
+                self.counts[index] += 1
+        self.count += 1
+        self.sum += value
+
+
+class MetricsRegistry:
+    """A thread-safe registry of histograms and counters.
+
+    Attributes:
+        metric_help (Dict[str, str]): Help text of each metric
+        metric_types (Dict[str, str]): Prometheus type of each metric
+    """
+
+    def __init__(self) -> None:
+        """Initialize an empty registry."""
+        self.metric_help: Dict[str, str] = {}
+        self.metric_types: Dict[str, str] = {}
+        self._histograms: Dict[str, Dict[Labels, _Histogram]] = {}
+        self._buckets: Dict[str, Sequence[float]] = {}
+        self._counters: Dict[str, Dict[Labels, float]] = {}
+        self._lock = threading.Lock()
+
+    def histogram(self, name: str, help_text: str, buckets: Sequence[float]) -> None:
+        """Declare a histogram metric.
+
+        Args:
+            name (str): Metric name
+            help_text (str): Description of the metric
+            buckets (Sequence[float]): Upper bounds of the histogram buckets
+        """
+        with self._lock:
+            self.metric_help[name] = help_text
+            self.metric_types[name] = "histogram"
+            self._buckets[name] = buckets
+            self._histograms.setdefault(name, {})
+
+    def counter(self, name: str, help_text: str) -> None:
+        """Declare a counter metric.
+
+        Args:
+            name (str): Metric name
+            help_text (str): Description of the metric
+        """
+        with self._lock:
+            self.metric_help[name] = help_text
+            self.metric_types[name] = "counter"
+            self._counters.setdefault(name, {})
+
+    def observe(self, name: str, value: float, **labels: str) -> None:
+        """Record a value in a declared histogram.
+
+        Args:
+            name (str): Metric name
+            value (float): Observed value
+            **labels (str): Label values of the series
+        """
+        key = tuple(sorted(labels.items()))
+        with self._lock:
+            series = self._histograms[name]
+            if key not in series:
+                series[key] = _Histogram(self._buckets[name])
+            series[key].observe(value)
+
+    def inc(self, name: str, value: float = 1, **labels: str) -> None:
+        """Increment a declared counter.
+
+        Args:
+            name (str): Metric name
+            value (float): Increment
+            **labels (str): Label values of the series
+        """
+        key = tuple(sorted(labels.items()))
+        with self._lock:
+            series = self._counters[name]
+            series[key] = series.get(key, 0) + value
+
+    @staticmethod
+    def _format_labels(labels: Labels, extra: Optional[Tuple[str, str]] = None) -> str:
+        items = list(labels) + ([extra] if extra else [])
+        if not items:
+            return ""
+        escaped = (
+            f'{key}="{value.replace(chr(92), chr(92) * 2).replace(chr(34), chr(92) + chr(34)).replace(chr(10), "")}"'
+            for key, value in items
+        )
+        return "{" + ",".join(escaped) + "}"
+
+    def render(self) -> str:
+        """Render all metrics in the Prometheus text exposition format.
+
+        Returns:
+            str: The metrics
+        """
+        lines: List[str] = []
+        with self._lock:
+            for name in sorted(self.metric_types):
+                lines.append(f"# HELP {name} {self.metric_help[name]}")
+                lines.append(f"# TYPE {name} {self.metric_types[name]}")
+                if self.metric_types[name] == "counter":
+                    for labels, value in sorted(self._counters[name].items()):
+                        lines.append(f"{name}{self._format_labels(labels)} {value:g}")
+                    continue
+                for labels, histogram in sorted(self._histograms[name].items()):
+                    for bound, count in zip(histogram.buckets, histogram.counts, strict=True):
+                        lines.append(f"{name}_bucket{self._format_labels(labels, ('le', f'{bound:g}'))} {count}")
+                    lines.append(f"{name}_bucket{self._format_labels(labels, ('le', '+Inf'))} {histogram.count}")
+                    lines.append(f"{name}_sum{self._format_labels(labels)} {histogram.sum:g}")
+                    lines.append(f"{name}_count{self._format_labels(labels)} {histogram.count}")
+
+        # ru_maxrss is reported in KiB on Linux and in bytes on macOS
+        max_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss * (1 if sys.platform == "darwin" else 1024)
+        lines.append("# HELP process_max_resident_memory_bytes Peak resident memory of the Python process.")
+        lines.append("# TYPE process_max_resident_memory_bytes gauge")
+        lines.append(f"process_max_resident_memory_bytes {max_rss}")
+        return "\n".join(lines) + "\n"
+
+
+METRICS = MetricsRegistry()
+METRICS.histogram("joern_analyzer_phase_duration_seconds", "Duration of analysis phases.", DURATION_BUCKETS)
+METRICS.histogram("joern_analyzer_output_size_bytes", "Size of analysis output files.", SIZE_BUCKETS)
+METRICS.histogram("joern_analyzer_output_items", "Number of items in analysis outputs.", COUNT_BUCKETS)
+METRICS.counter("joern_analyzer_runs_total", "Number of analysis runs by status.")
+METRICS.histogram(
+    "joern_analyzer_container_cpu_seconds", "CPU time used by the Joern container per run.", DURATION_BUCKETS
+)
+METRICS.histogram(
+    "joern_analyzer_container_memory_peak_bytes", "Peak memory of the Joern container per run.", SIZE_BUCKETS
+)
+
+# Resources of a run reported as histograms when the run finishes
+RESOURCE_METRICS = {
+    "container_cpu_seconds": "joern_analyzer_container_cpu_seconds",
+    "container_memory_peak_bytes": "joern_analyzer_container_memory_peak_bytes",
+}
+
+
+class RunTimings:
+    """Phase timings, output sizes and item counts of a single analysis run.
+
+    Every recorded value is also reported to the process-wide METRICS registry.
+
+    Attributes:
+        phases (Dict[str, float]): Duration of each phase in seconds, in execution order
+        sizes (Dict[str, int]): Size of each output file in bytes
+        counts (Dict[str, int]): Number of items of each kind
+        resources (Dict[str, float]): Resource usage, e.g. CPU time and peak memory of the container
+        status (str): "running", "success", "partial" (finished with files skipped) or "failure"
+        mode (str): Analysis mode of the run, "full" or "signatures"
+    """
+
+    def __init__(self, mode: str = "full") -> None:
+        """Initialize empty run timings.
+
+        Args:
+            mode (str): Analysis mode of the run, "full" or "signatures"
+        """
+        self.phases: Dict[str, float] = {}
+        self.sizes: Dict[str, int] = {}
+        self.counts: Dict[str, int] = {}
+        self.resources: Dict[str, float] = {}
+        self.status = "running"
+        self.mode = mode
+        self._started = time.perf_counter()
+        # Resources are updated and the timings saved from the resource sampler thread
+        self._lock = threading.Lock()
+        self._save_lock = threading.Lock()
+
+    @contextmanager
+    def phase(self, name: str) -> Iterator[None]:
+        """Time a phase of the run and trace it as a span.
+
+        Args:
+            name (str): Phase name; durations of repeated phases are added up
+        """
+        start = time.perf_counter()
+        try:
+            with TRACER.span(name):
+                yield
+        finally:
+            duration = time.perf_counter() - start
+            with self._lock:
+                self.phases[name] = self.phases.get(name, 0.0) + duration
+            METRICS.observe("joern_analyzer_phase_duration_seconds", duration, phase=name)
+
+    def record_phase(self, name: str, duration: float) -> None:
+        """Record the duration of a phase that was timed elsewhere, e.g. in the container.
+
+        Args:
+            name (str): Phase name; durations of repeated phases are added up
+            duration (float): Duration in seconds
+        """
+        with self._lock:
+            self.phases[name] = self.phases.get(name, 0.0) + duration
+        METRICS.observe("joern_analyzer_phase_duration_seconds", duration, phase=name)
+
+    def record_size(self, path: Path) -> None:
+        """Record the size of an output file, if it exists.
+
+        Args:
+            path (Path): The output file
+        """
+        if path.exists():
+            size = path.stat().st_size
+            self.sizes[path.name] = size
+            METRICS.observe("joern_analyzer_output_size_bytes", size, file=path.name)
+
+    def record_count(self, kind: str, count: int) -> None:
+        """Record the number of items of an output.
+
+        Args:
+            kind (str): Kind of items, e.g. "functions" or "calls"
+            count (int): Number of items
+        """
+        self.counts[kind] = count
+        METRICS.observe("joern_analyzer_output_items", count, kind=kind)
+
+    def record_resources(self, usage: Dict[str, float]) -> None:
+        """Record the resource usage of the run so far.
+
+        Args:
+            usage (Dict[str, float]): Usage by resource, e.g. "container_cpu_seconds"
+        """
+        with self._lock:
+            self.resources.update(usage)
+
+    def finish(self, success: bool, complete: bool = True) -> None:
+        """Mark the run as finished.
+
+        Args:
+            success (bool): Whether the run succeeded
+            complete (bool): Whether all files were analyzed
+        """
+        self.status = ("success" if complete else "partial") if success else "failure"
+        METRICS.inc("joern_analyzer_runs_total", status=self.status, mode=self.mode)
+        for resource_name, metric in RESOURCE_METRICS.items():
+            if resource_name in self.resources:
+                METRICS.observe(metric, self.resources[resource_name])
+
+    def to_dict(self) -> Dict[str, object]:
+        """Get the run timings as a JSON-compatible dictionary.
+
+        Returns:
+            Dict[str, object]: Status, mode, total wall time, phases, sizes, counts and resources
+        """
+        with self._lock:
+            return {
+                "status": self.status,
+                "mode": self.mode,
+                "total_seconds": time.perf_counter() - self._started,
+                "phases": dict(self.phases),
+                "sizes": dict(self.sizes),
+                "counts": dict(self.counts),
+                "resources": dict(self.resources),
+            }
+
+    def save(self, output_file: Path) -> None:
+        """Save the run timings as JSON.
+
+        The file is replaced atomically, so that it can be read while the run is
+        still updating it.
+
+        Args:
+            output_file (Path): Path where the timings will be saved
+        """
+        with self._save_lock:
+            temp_file = output_file.with_suffix(".json.tmp")
+            if FileHandler.write_json(self.to_dict(), temp_file):
+                temp_file.replace(output_file)
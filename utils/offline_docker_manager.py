@@ -0,0 +1,317 @@
+"""Offline Docker Manager Module
+
+This module provides a stand-in for DockerManager that needs neither Docker nor the
+Joern image, so that the results processing, the API and the caching layers can be
+tested and profiled in isolation.
+
+No container is started. The commands the analyzer runs in the container are
+emulated on the host, with the container paths mapped to the mounted host paths:
+- mkdir creates the directory, chmod does nothing, rm -f removes files
+- c2cpg writes an empty CPG file
+- A tmpfs is a temporary host directory, removed when the container stops, and
+  find <tmpfs> -mindepth 1 -delete empties it
+- Updating the limits of the container does nothing
+- The stages of pipeline.sh are emulated in turn, with the stage events written like
+  the script does; cd does nothing
+- The analysis script writes functions.json and call_graph.json to RESULTS_DIR, in
+  signatures mode without code, external functions and operator calls like
+  analysis.sc
+
+The Joern output is taken from, in this order:
+- The recorded output configured as "replay" in OFFLINE_SETTINGS
+- The output synthesized for a generated codebase, i.e. code in CODE_DIR with a
+  manifest.json (see generate_test_code.py)
+- The recorded output next to the analyzed code, i.e. <code dir>_results.json like
+  test_code/simple_results.json
+
+Without any of these, the analysis script fails, so that no output unrelated to the
+analyzed code is processed or benchmarked.
+
+Every other command fails, so e.g. profiling produces no recordings.
+"""
+
+import json
+import shlex
+import shutil
+import tempfile
+import time
+import uuid
+from pathlib import Path
+from typing import Any, Collection, Dict, List, Optional, Tuple, Union, cast
+
+from loguru import logger
+
+from generate_test_code import GeneratorParameters, synthesize_results
+from settings import CONTAINER_PATHS, OFFLINE_SETTINGS
+from utils.docker_manager import DockerManager
+from utils.file_handler import FileHandler
+from utils.job_scheduler import Allocation
+from utils.tracing import SPAN_KIND_CLIENT, TRACER
+
+
+class OfflineDockerManager(DockerManager):
+    """Emulates the Joern container on the host.
+
+    Attributes:
+        mounts (Dict[str, Path]): Host path of each mounted container path
+        tmpfs_paths (List[Path]): Host directories standing in for the tmpfs mounts
+    """
+
+    def __init__(self, image: str, platform: str = "linux/amd64"):
+        """Initialize the offline Docker manager.
+
+        Args:
+            image: Docker image the analyzer asks for, only used for logging
+            platform: Platform the analyzer asks for, unused
+        """
+        super().__init__(image, platform)
+        self.mounts: Dict[str, Path] = {}
+        self.tmpfs_paths: List[Path] = []
+
+    def start_container(
+        self,
+        image: str,
+        command: List[str],
+        volumes: Dict[str, Dict[str, str]],
+        environment: Dict[str, str],
+        working_dir: str = "/app",
+        allocation: Optional[Allocation] = None,
+        tmpfs: Optional[Dict[str, str]] = None,
+    ) -> bool:
+        """Record the volume mounts instead of starting a container.
+
+        Args:
+            image: Docker image to use
+            command: Command to run in the container
+            volumes: Dictionary mapping host paths to container paths with mode
+            environment: Dictionary of environment variables
+            working_dir: Working directory inside the container
+            allocation: CPUs and memory of the job, unused
+            tmpfs: Container paths of tmpfs mounts, emulated with temporary directories
+
+        Returns:
+            bool: Always True
+        """
+        self.mounts = {mount_info["bind"]: Path(host_path) for host_path, mount_info in volumes.items()}
+        for container_path in tmpfs or {}:
+            self.tmpfs_paths.append(Path(tempfile.mkdtemp(prefix="joern-tmpfs-")))
+            self.mounts[container_path] = self.tmpfs_paths[-1]
+        self.container_id = f"offline-{uuid.uuid4().hex[:12]}"
+        logger.info(f"Offline backend standing in for {image} with ID: {self.container_id}")
+        return True
+
+    def update_limits(self, allocation: Allocation) -> bool:
+        """There are no limits without a container.
+
+        Returns:
+            bool: True if a container is emulated, False otherwise
+        """
+        return self.container_id is not None
+
+    def stop_container(self) -> bool:
+        """Forget the volume mounts.
+
+        Returns:
+            bool: True if a container was emulated, False otherwise
+        """
+        if not self.container_id:
+            logger.warning("No container ID available to stop")
+            return False
+
+        self.container_id = None
+        self.mounts = {}
+        for tmpfs_path in self.tmpfs_paths:
+            shutil.rmtree(tmpfs_path, ignore_errors=True)
+        self.tmpfs_paths = []
+        return True
+
+    def execute_command(
+        self, command: Union[List[str], Collection[str]], timeout: int = 60, input: Optional[str] = None
+    ) -> Tuple[bool, str, str]:
+        """Emulate a command of the analyzer on the host.
+
+        Args:
+            command: List of command arguments to execute
+            timeout: Command timeout in seconds, unused
+            input: Optional input string to send to the command, unused
+
+        Returns:
+            Tuple of (success, stdout, stderr)
+        """
+        if not self.container_id:
+            return False, "", "No container running"
+
+        command = list(command)
+        with TRACER.span(
+            "docker.exec", kind=SPAN_KIND_CLIENT, attributes={"process.executable.name": command[0]}
+        ) as span:
+            try:
+                success, stdout, stderr = self._emulate(command)
+            except (OSError, ValueError) as e:
+                success, stdout, stderr = False, "", str(e)
+            if not success:
+                logger.error(f"Offline command failed: {' '.join(command)}: {stderr}")
+                span.set_error(stderr)
+            return success, stdout, stderr
+
+    def read_cgroup_stats(self, script: str, timeout: int = 10) -> Optional[str]:
+        """There are no cgroup counters without a container.
+
+        Returns:
+            Optional[str]: Always None
+        """
+        return None
+
+    def _host_path(self, container_path: str) -> Path:
+        """Map a container path to the host path of its mount.
+
+        Raises:
+            ValueError: If the path is not inside a mounted directory
+        """
+        for bind, host_path in self.mounts.items():
+            if container_path == bind or container_path.startswith(bind + "/"):
+                return host_path / container_path[len(bind) :].lstrip("/")
+        raise ValueError(f"Path not mounted in the offline backend: {container_path}")
+
+    def _emulate(self, command: List[str]) -> Tuple[bool, str, str]:
+        """Emulate mkdir, chmod, rm -f, find, c2cpg and the analysis script.
+
+        Returns:
+            Tuple of (success, stdout, stderr)
+        """
+        if any(arg.endswith("pipeline.sh") for arg in command):
+            script = next(index for index, arg in enumerate(command) if arg.endswith("pipeline.sh"))
+            return self._emulate_pipeline(command[script + 1], command[script + 2 :])
+        if command[0] == "cd":
+            return True, "", ""
+        if command[0] == "mkdir":
+            self._host_path(command[-1]).mkdir(parents=True, exist_ok=True)
+            return True, "", ""
+        if command[0] == "chmod":
+            return True, "", ""
+        if command[:2] == ["rm", "-f"]:
+            for path in command[2:]:
+                self._host_path(path).unlink(missing_ok=True)
+            return True, "", ""
+        if command[0] == "find" and command[2:] == ["-mindepth", "1", "-delete"]:
+            directory = self._host_path(command[1])
+            if directory not in self.tmpfs_paths:
+                return False, "", f"Not a tmpfs in the offline backend: {command[1]}"
+            for child in directory.iterdir():
+                if child.is_dir():
+                    shutil.rmtree(child)
+                else:
+                    child.unlink()
+            return True, "", ""
+        if any(arg.endswith("c2cpg.sh") for arg in command):
+            self._host_path(command[command.index("--output") + 1]).write_bytes(b"")
+            return True, "", ""
+        if any("analysis.sc" in arg for arg in command):
+            functions, call_graph = self._joern_output(self._command_env(command, "CODE_DIR", CONTAINER_PATHS["app"]))
+            if any("ANALYSIS_MODE=signatures" in arg for arg in command):
+                functions = [
+                    {key: value for key, value in function.items() if key != "code"}
+                    for function in functions
+                    if function.get("code") != "<empty>" and function.get("file") not in ("<unknown>", "<includes>")
+                ]
+                call_graph = [call for call in call_graph if not call.get("name", "").startswith("<operator>")]
+            results_path = self._host_path(self._command_env(command, "RESULTS_DIR", CONTAINER_PATHS["results"]))
+            FileHandler.write_json(functions, results_path / "functions.json")
+            FileHandler.write_json(call_graph, results_path / "call_graph.json")
+            return True, f"Wrote {len(functions)} functions and {len(call_graph)} calls", ""
+        return False, "", "Command not supported by the offline backend"
+
+    def _emulate_pipeline(self, events_file: str, stages: List[str]) -> Tuple[bool, str, str]:
+        """Emulate the stages of pipeline.sh, each a chain of commands joined by &&.
+
+        Returns:
+            Tuple of (success, stdout, stderr)
+        """
+        events_path = self._host_path(events_file)
+        # Docker creates a missing host directory of a bind mount
+        events_path.parent.mkdir(parents=True, exist_ok=True)
+        events_path.write_text("")
+        output = []
+        for stage in stages:
+            name, line = stage.split("=", 1)
+            start = time.perf_counter()
+            success, stdout, stderr = True, "", ""
+            for part in line.split(" && "):
+                try:
+                    success, stdout, stderr = self._emulate(shlex.split(part))
+                except (OSError, ValueError) as e:
+                    success, stdout, stderr = False, "", str(e)
+                output.append((stdout, stderr))
+                if not success:
+                    break
+            event = {
+                "stage": name,
+                "exit_code": 0 if success else 1,
+                "milliseconds": int((time.perf_counter() - start) * 1000),
+            }
+            with events_path.open("a") as events:
+                events.write(json.dumps(event) + "\n")
+            if not success:
+                break
+        return success, "".join(out for out, _ in output), "".join(err for _, err in output)
+
+    @staticmethod
+    def _command_env(command: List[str], name: str, default: str) -> str:
+        """Get an environment variable set with env in a command, which may be a shell command line.
+
+        Returns:
+            str: The value, or the default if the command does not set it
+        """
+        for arg in command:
+            for word in shlex.split(arg) if " " in arg else [arg]:
+                if word.startswith(f"{name}="):
+                    return word[len(name) + 1 :]
+        return default
+
+    def _joern_output(self, code_dir: str) -> Tuple[List[Dict[str, Any]], List[Dict[str, Any]]]:
+        """Get the functions and calls to write as the output of the analysis script.
+
+        Args:
+            code_dir: Container directory of the analyzed code
+
+        Returns:
+            Tuple[List[Dict[str, Any]], List[Dict[str, Any]]]: The function and call records
+
+        Raises:
+            ValueError: If the replayed results file has no functions and call graph,
+                or there is no output for the analyzed code
+        """
+        replay = Path(OFFLINE_SETTINGS["replay"]) if OFFLINE_SETTINGS["replay"] else None
+        if replay and replay.is_dir():
+            logger.info(f"Replaying Joern output from {replay}")
+            return FileHandler.read_json(replay / "functions.json"), FileHandler.read_json(replay / "call_graph.json")
+        if replay:
+            return self._replay_results_file(replay)
+
+        code_path = self._host_path(code_dir)
+        manifest_file = code_path / "manifest.json"
+        if manifest_file.exists():
+            params = GeneratorParameters(**cast(Dict[str, Any], FileHandler.read_json(manifest_file))["parameters"])
+            logger.info(f"Synthesizing Joern output for {params.files}x{params.functions_per_file} functions")
+            return synthesize_results(params)
+
+        recorded = code_path.resolve().parent / f"{code_path.resolve().name}_results.json"
+        if recorded.exists():
+            return self._replay_results_file(recorded)
+        raise ValueError(
+            f"No Joern output for {code_path} in the offline backend: configure replay in OFFLINE_SETTINGS, "
+            f"record the output as {recorded.name} next to the code, or analyze a generated codebase"
+        )
+
+    @staticmethod
+    def _replay_results_file(results_file: Path) -> Tuple[List[Dict[str, Any]], List[Dict[str, Any]]]:
+        """Read the functions and calls of a results file like test_code/*_results.json.
+
+        Raises:
+            ValueError: If the file has no functions and call graph
+        """
+        logger.info(f"Replaying Joern output from {results_file}")
+        results = cast(Any, FileHandler.read_json(results_file))
+        if not isinstance(results, dict) or "functions" not in results or "call_graph" not in results:
+            raise ValueError(f"No functions and call_graph to replay in {results_file}")
+        return results["functions"], results["call_graph"]
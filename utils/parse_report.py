@@ -0,0 +1,101 @@
+"""Parse Report Module
+
+This module builds a per-file cost report of the c2cpg run, to find the files
+(e.g. macro-heavy, generated or with huge tables) that account for most of the
+parse time and are candidates for an exclude list.
+
+The report combines:
+- The per-file report of the x2cpg frontend, which c2cpg logs at debug level as a
+  table with the lines of code, whether the file was parsed, whether a CPG was
+  generated and the CPG generation duration of every file
+- The number of methods and AST nodes of every file, counted in the CPG by
+  analysis.sc and written to file_nodes.json
+"""
+
+import re
+from typing import Any, Dict, Iterable, List, Optional
+
+# Container directory of the analyzed code, stripped from the file names
+APP_PATH = "/app"
+
+_DURATION_UNITS = {"h": 3600.0, "m": 60.0, "min": 60.0, "s": 1.0, "sec": 1.0, "ms": 1e-3, "us": 1e-6, "µs": 1e-6}
+_DURATION_PART = re.compile(r"(\d+(?:\.\d+)?)\s*(h|min|ms|µs|us|sec|s|m)\b")
+_DURATION = re.compile(r"^(?:\d+(?:\.\d+)?\s*(?:h|min|ms|µs|us|sec|s|m)\s*)+$")
+
+
+def _relative_name(name: str, app_path: str) -> str:
+    """Get the file name relative to the analyzed code directory."""
+    prefix = app_path.rstrip("/") + "/"
+    return name[len(prefix) :] if name.startswith(prefix) else name
+
+
+def _duration_seconds(value: str) -> Optional[float]:
+    """Convert a duration like "1s 234ms" or "15 ms" to seconds, or None if it is none."""
+    value = value.strip()
+    if not _DURATION.match(value):
+        return None
+    return sum(float(number) * _DURATION_UNITS[unit] for number, unit in _DURATION_PART.findall(value))
+
+
+def parse_frontend_report(output: str, app_path: str = APP_PATH) -> Dict[str, Dict[str, Any]]:
+    """Parse the per-file report from the c2cpg output.
+
+    Report rows look like "| <file> | <LOC> | yes | yes | 1s 234ms |". Any other
+    output, including the header of the table, is skipped.
+
+    Args:
+        output (str): Standard output and error of c2cpg
+        app_path (str): Container directory of the analyzed code
+
+    Returns:
+        Dict[str, Dict[str, Any]]: For each file, "loc", "parsed", "cpg" and "seconds"
+    """
+    files: Dict[str, Dict[str, Any]] = {}
+    for line in output.splitlines():
+        cells = [cell.strip() for cell in line.strip().strip("|").split("|")]
+        if len(cells) < 5 or not cells[1].isdigit():
+            continue
+        seconds = _duration_seconds(cells[-1])
+        if seconds is None:
+            continue
+        files[_relative_name(cells[0], app_path)] = {
+            "loc": int(cells[1]),
+            "parsed": cells[2].lower() == "yes",
+            "cpg": cells[3].lower() == "yes",
+            "seconds": seconds,
+        }
+    return files
+
+
+def build_parse_report(
+    frontend_report: Dict[str, Dict[str, Any]], file_nodes: Iterable[Dict[str, Any]], app_path: str = APP_PATH
+) -> List[Dict[str, Any]]:
+    """Combine the frontend report and the node counts into the parse report.
+
+    Args:
+        frontend_report (Dict[str, Dict[str, Any]]): Report as returned by
+            parse_frontend_report()
+        file_nodes (Iterable[Dict[str, Any]]): Node counts as written by analysis.sc,
+            each with "file", "methods" and "nodes"
+        app_path (str): Container directory of the analyzed code
+
+    Returns:
+        List[Dict[str, Any]]: One entry per file with "file", "seconds", "loc",
+            "parsed", "cpg", "methods" and "nodes" (None where unknown), the most
+            expensive files first: by duration, then by number of nodes
+    """
+    entries: Dict[str, Dict[str, Any]] = {}
+    empty = {"seconds": None, "loc": None, "parsed": None, "cpg": None, "methods": None, "nodes": None}
+    for name, values in frontend_report.items():
+        entries[name] = {"file": name, **empty, **values}
+    for values in file_nodes:
+        name = _relative_name(str(values.get("file", "")), app_path)
+        if not name or name.startswith("<"):
+            continue
+        entry = entries.setdefault(name, {"file": name, **empty})
+        entry["methods"] = values.get("methods")
+        entry["nodes"] = values.get("nodes")
+
+    return sorted(
+        entries.values(), key=lambda entry: (-(entry["seconds"] or 0.0), -(entry["nodes"] or 0), entry["file"])
+    )
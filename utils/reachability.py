@@ -0,0 +1,312 @@
+"""Reachability Index Module
+
+This module provides a precomputed index for answering "can function A transitively
+call function B" queries without a breadth-first search over the call graph per query.
+
+The index is built on the condensation of the call graph (one node per strongly
+connected component), which is a DAG. It combines:
+- Randomized interval labels (GRAIL): if the interval of B is not contained in the
+  interval of A, B is certainly unreachable from A. Otherwise a depth-first search
+  over the DAG, pruned by the same labels, decides the query.
+- Sink labels: a bitset per component over a fixed set of sink functions (by default
+  the system functions), which answers source-to-sink queries with a single bit test.
+
+Reachability is reflexive: every function reaches itself.
+"""
+
+import random
+from array import array
+from typing import Any, Dict, Iterable, List, Optional, Set
+
+from utils.call_graph import CallGraph
+
+
+class ReachabilityIndex:
+    """A reachability index over the SCC-condensed call graph.
+
+    Attributes:
+        names (List[str]): Function name of each node id
+        ids (Dict[str, int]): Mapping of function names to node ids
+        comp (List[int]): Component id of each node
+        dag (CallGraph): Condensed call graph, with edges from higher to lower component ids
+        intervals (List[List[array]]): Per labeling, the ``[low, rank]`` arrays of each component
+        sinks (List[str]): Sink function names; sink ``i`` is bit ``i`` of the sink labels
+        sink_labels (List[int]): Bitset of reachable sinks per component
+    """
+
+    def __init__(
+        self,
+        names: List[str],
+        comp: List[int],
+        dag: CallGraph,
+        intervals: List[List[array]],
+        sinks: List[str],
+        sink_labels: List[int],
+    ):
+        """Initialize the index from its precomputed parts.
+
+        Use build() or from_dict() instead of calling this directly.
+        """
+        self.names = names
+        self.ids = {name: node for node, name in enumerate(names)}
+        self.comp = comp
+        self.dag = dag
+        self.intervals = intervals
+        self.sinks = sinks
+        self.sink_bits = {name: 1 << bit for bit, name in enumerate(sinks)}
+        self.sink_labels = sink_labels
+
+    @classmethod
+    def build(
+        cls,
+        graph: CallGraph,
+        sinks: Iterable[str],
+        num_intervals: int = 2,
+        seed: int = 0,
+        comp: Optional[List[int]] = None,
+    ) -> "ReachabilityIndex":
+        """Build the index for a call graph.
+
+        Args:
+            graph (CallGraph): The call graph to index
+            sinks (Iterable[str]): Sink function names to precompute labels for;
+                names that are not part of the graph are ignored
+            num_intervals (int): Number of randomized interval labelings
+            seed (int): Seed for the randomized traversals, for reproducible indexes
+            comp (Optional[List[int]]): Precomputed component id of each node, as returned by
+                CallGraph.strongly_connected_components(); computed if not given
+
+        Returns:
+            ReachabilityIndex: The index
+        """
+        if comp is None:
+            comp = graph.strongly_connected_components()
+        dag = graph.condense(comp)
+
+        rng = random.Random(seed)
+        intervals = [cls._interval_labels(dag, rng) for _ in range(num_intervals)]
+
+        present_sinks = sorted(name for name in set(sinks) if name in graph.ids)
+        own = [0] * dag.num_nodes
+        for bit, name in enumerate(present_sinks):
+            own[comp[graph.ids[name]]] |= 1 << bit
+
+        return cls(graph.names, comp, dag, intervals, present_sinks, cls._propagate(dag, own))
+
+    @staticmethod
+    def _interval_labels(dag: CallGraph, rng: random.Random) -> List[array]:
+        """Compute one randomized interval labeling of a DAG.
+
+        Each component gets its post-order rank in a randomized depth-first traversal
+        and the lowest rank of any component reachable from it.
+
+        Args:
+            dag (CallGraph): The condensed call graph
+            rng (random.Random): Source of randomness for the child order
+
+        Returns:
+            List[array]: The ``[low, rank]`` arrays
+        """
+        num_nodes = dag.num_nodes
+        low = array("q", [-1]) * num_nodes
+        rank = array("q", [-1]) * num_nodes
+        visited = bytearray(num_nodes)
+        counter = 0
+
+        # Sources of the DAG have the highest ids; start there so that traversals are long
+        roots = list(range(num_nodes - 1, -1, -1))
+        for root in roots:
+            if visited[root]:
+                continue
+            visited[root] = 1
+            children = list(dag.successors(root))
+            rng.shuffle(children)
+            work = [(root, children)]
+
+            while work:
+                node, pending = work[-1]
+                if pending:
+                    child = pending.pop()
+                    if not visited[child]:
+                        visited[child] = 1
+                        grandchildren = list(dag.successors(child))
+                        rng.shuffle(grandchildren)
+                        work.append((child, grandchildren))
+                    continue
+
+                work.pop()
+                rank[node] = counter
+                node_low = counter
+                for child in dag.successors(node):
+                    if low[child] < node_low:
+                        node_low = low[child]
+                low[node] = node_low
+                counter += 1
+
+        return [low, rank]
+
+    @staticmethod
+    def _propagate(dag: CallGraph, own: List[int]) -> List[int]:
+        """Propagate per-component bitsets to every component that can reach them.
+
+        Component ids are in reverse topological order, so a single pass in
+        increasing id order sees every successor before its predecessors.
+
+        Args:
+            dag (CallGraph): The condensed call graph
+            own (List[int]): Bits set directly on each component
+
+        Returns:
+            List[int]: Union of the bits of every component reachable from each component
+        """
+        labels = list(own)
+        for component in range(dag.num_nodes):
+            label = labels[component]
+            for succ in dag.successors(component):
+                label |= labels[succ]
+            labels[component] = label
+        return labels
+
+    def _may_reach(self, source: int, target: int) -> bool:
+        """Check the interval labels of two components.
+
+        Returns:
+            bool: False if the target is certainly unreachable from the source
+        """
+        if source < target:
+            return False
+        for low, rank in self.intervals:
+            if low[target] < low[source] or rank[target] > rank[source]:
+                return False
+        return True
+
+    def _component_reaches(self, source: int, target: int) -> bool:
+        """Decide reachability between two components with a label-pruned search."""
+        if source == target:
+            return True
+        if not self._may_reach(source, target):
+            return False
+
+        seen = {source}
+        stack = [source]
+        while stack:
+            node = stack.pop()
+            for succ in self.dag.successors(node):
+                if succ == target:
+                    return True
+                if succ not in seen and self._may_reach(succ, target):
+                    seen.add(succ)
+                    stack.append(succ)
+        return False
+
+    def can_reach(self, source: str, target: str) -> bool:
+        """Check whether a function can transitively call another function.
+
+        Args:
+            source (str): Name of the calling function
+            target (str): Name of the (transitively) called function
+
+        Returns:
+            bool: True if target is reachable from source; False if it is not or
+                either function is unknown
+        """
+        source_id, target_id = self.ids.get(source), self.ids.get(target)
+        if source_id is None or target_id is None:
+            return False
+
+        source_comp = self.comp[source_id]
+        sink_bit = self.sink_bits.get(target)
+        if sink_bit is not None:
+            return bool(self.sink_labels[source_comp] & sink_bit)
+        return self._component_reaches(source_comp, self.comp[target_id])
+
+    def reachable_targets(
+        self, sources: Iterable[str], targets: Optional[Iterable[str]] = None
+    ) -> Dict[str, List[str]]:
+        """Answer many-to-many reachability queries in one pass.
+
+        When all targets are sinks, the precomputed sink labels are used directly.
+        Otherwise labels for the requested targets are computed in a single linear
+        pass over the condensed graph.
+
+        Args:
+            sources (Iterable[str]): Names of the calling functions
+            targets (Optional[Iterable[str]]): Names of the called functions;
+                defaults to the sinks of the index
+
+        Returns:
+            Dict[str, List[str]]: Sorted reachable targets for each known source
+        """
+        target_names = sorted(set(self.sinks if targets is None else targets) & self.ids.keys())
+
+        if all(name in self.sink_bits for name in target_names):
+            bits = self.sink_bits
+            labels = self.sink_labels
+        else:
+            bits = {name: 1 << bit for bit, name in enumerate(target_names)}
+            own = [0] * self.dag.num_nodes
+            for name, bit in bits.items():
+                own[self.comp[self.ids[name]]] |= bit
+            labels = self._propagate(self.dag, own)
+
+        result: Dict[str, List[str]] = {}
+        for source in sources:
+            source_id = self.ids.get(source)
+            if source_id is None:
+                continue
+            label = labels[self.comp[source_id]]
+            result[source] = [name for name in target_names if label & bits[name]]
+        return result
+
+    def unknown_functions(self, names: Iterable[str]) -> Set[str]:
+        """Get the names that are not part of the indexed call graph.
+
+        Args:
+            names (Iterable[str]): Function names to check
+
+        Returns:
+            Set[str]: The unknown names
+        """
+        return set(names) - self.ids.keys()
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Serialize the index into a JSON-compatible dictionary.
+
+        Returns:
+            Dict[str, Any]: The serialized index
+        """
+        return {
+            "names": self.names,
+            "components": self.comp,
+            "dag": {"offsets": self.dag.offsets.tolist(), "targets": self.dag.targets.tolist()},
+            "intervals": [[low.tolist(), rank.tolist()] for low, rank in self.intervals],
+            "sinks": self.sinks,
+            "sink_labels": [format(label, "x") for label in self.sink_labels],
+        }
+
+    @classmethod
+    def from_dict(cls, data: Dict[str, Any]) -> "ReachabilityIndex":
+        """Deserialize an index written by to_dict().
+
+        Args:
+            data (Dict[str, Any]): The serialized index
+
+        Returns:
+            ReachabilityIndex: The index
+        """
+        comp = data["components"]
+        num_components = len(data["dag"]["offsets"]) - 1
+        labels = [""] * num_components
+        for node, component in enumerate(comp):
+            if not labels[component] or data["names"][node] < labels[component]:
+                labels[component] = data["names"][node]
+        dag = CallGraph(labels, array("q", data["dag"]["offsets"]), array("q", data["dag"]["targets"]))
+
+        return cls(
+            data["names"],
+            comp,
+            dag,
+            [[array("q", low), array("q", rank)] for low, rank in data["intervals"]],
+            data["sinks"],
+            [int(label, 16) for label in data["sink_labels"]],
+        )
@@ -0,0 +1,257 @@
+"""Resource Sampler Module
+
+This module samples the resource usage of the Joern container from its cgroup while a
+job runs:
+- CPU time (total, user, system and throttled)
+- Memory (current and peak)
+- Block I/O (bytes and operations read and written)
+- OOM kills
+
+The cgroup v2 interface files are read, with a fallback to cgroup v1 for CPU, memory
+and block I/O. All counters are cumulative over the lifetime of the container, so the
+last sample is the usage of the job.
+
+A container that is kept running between jobs (batch mode) is sampled relative to the
+start of the job: the CPU, I/O and OOM kill counters of the first sample are
+subtracted, and the peak memory is the highest sampled current memory, since the
+peak of the cgroup covers the earlier jobs.
+"""
+
+import threading
+import time
+from typing import Any, Callable, Dict, List, Optional
+
+from loguru import logger
+
+from utils.docker_manager import DockerManager
+
+# Shell script printing the cgroup files of the container, each after a "== <name>" line
+CGROUP_STATS_SCRIPT = " ".join(
+    [
+        "cd /sys/fs/cgroup;",
+        "for f in cpu.stat memory.current memory.peak memory.events io.stat",
+        "cpuacct/cpuacct.usage memory/memory.usage_in_bytes memory/memory.max_usage_in_bytes",
+        "blkio/blkio.throttle.io_service_bytes blkio/blkio.throttle.io_serviced;",
+        'do [ -r "$f" ] && echo "== $f" && cat "$f";',
+        "done",
+    ]
+)
+
+# Prefixes of the counters that accumulate over the lifetime of the container
+CUMULATIVE_PREFIXES = ("container_cpu_", "container_io_", "container_oom_")
+
+
+def _parse_sections(output: str) -> Dict[str, List[str]]:
+    """Split the output of CGROUP_STATS_SCRIPT into the lines of each file."""
+    sections: Dict[str, List[str]] = {}
+    current: Optional[List[str]] = None
+    for line in output.splitlines():
+        if line.startswith("== "):
+            current = sections.setdefault(line[3:].strip(), [])
+        elif current is not None and line.strip():
+            current.append(line.strip())
+    return sections
+
+
+def _keyed_values(lines: List[str]) -> Dict[str, int]:
+    """Parse "<key> <value>" lines of a cgroup file."""
+    values = {}
+    for line in lines:
+        parts = line.split()
+        if len(parts) == 2 and parts[1].isdigit():
+            values[parts[0]] = int(parts[1])
+    return values
+
+
+def _single_value(lines: Optional[List[str]]) -> Optional[int]:
+    """Parse a cgroup file holding a single number."""
+    if lines and lines[0].isdigit():
+        return int(lines[0])
+    return None
+
+
+def parse_cgroup_stats(output: str) -> Dict[str, float]:
+    """Parse the output of CGROUP_STATS_SCRIPT.
+
+    Args:
+        output (str): The output
+
+    Returns:
+        Dict[str, float]: The available counters of container_cpu_seconds,
+            container_cpu_user_seconds, container_cpu_system_seconds,
+            container_cpu_throttled_seconds, container_memory_current_bytes,
+            container_memory_peak_bytes, container_io_read_bytes,
+            container_io_write_bytes, container_io_read_ops, container_io_write_ops
+            and container_oom_kills
+    """
+    sections = _parse_sections(output)
+    stats: Dict[str, float] = {}
+
+    if "cpu.stat" in sections:
+        cpu = _keyed_values(sections["cpu.stat"])
+        for key, name in (("usage_usec", "cpu"), ("user_usec", "cpu_user"), ("system_usec", "cpu_system")):
+            if key in cpu:
+                stats[f"container_{name}_seconds"] = cpu[key] / 1e6
+        if "throttled_usec" in cpu:
+            stats["container_cpu_throttled_seconds"] = cpu["throttled_usec"] / 1e6
+    elif (usage := _single_value(sections.get("cpuacct/cpuacct.usage"))) is not None:
+        stats["container_cpu_seconds"] = usage / 1e9
+
+    for names, key in (
+        (("memory.current", "memory/memory.usage_in_bytes"), "container_memory_current_bytes"),
+        (("memory.peak", "memory/memory.max_usage_in_bytes"), "container_memory_peak_bytes"),
+    ):
+        for name in names:
+            if (value := _single_value(sections.get(name))) is not None:
+                stats[key] = value
+                break
+
+    if "memory.events" in sections:
+        stats["container_oom_kills"] = _keyed_values(sections["memory.events"]).get("oom_kill", 0)
+
+    if "io.stat" in sections:
+        totals = {"rbytes": 0, "wbytes": 0, "rios": 0, "wios": 0}
+        for line in sections["io.stat"]:
+            # "<major>:<minor> rbytes=... wbytes=... rios=... wios=... dbytes=... dios=..."
+            for field in line.split()[1:]:
+                counter, _, count = field.partition("=")
+                if counter in totals and count.isdigit():
+                    totals[counter] += int(count)
+        stats.update(
+            {
+                "container_io_read_bytes": totals["rbytes"],
+                "container_io_write_bytes": totals["wbytes"],
+                "container_io_read_ops": totals["rios"],
+                "container_io_write_ops": totals["wios"],
+            }
+        )
+    else:
+        for name, unit in (
+            ("blkio/blkio.throttle.io_service_bytes", "bytes"),
+            ("blkio/blkio.throttle.io_serviced", "ops"),
+        ):
+            if name in sections:
+                # "<major>:<minor> <Read|Write|...> <value>"
+                read = write = 0
+                for line in sections[name]:
+                    parts = line.split()
+                    if len(parts) == 3 and parts[2].isdigit():
+                        read += int(parts[2]) if parts[1] == "Read" else 0
+                        write += int(parts[2]) if parts[1] == "Write" else 0
+                stats[f"container_io_read_{unit}"] = read
+                stats[f"container_io_write_{unit}"] = write
+
+    return stats
+
+
+class ResourceSampler:
+    """Samples the cgroup counters of a container in a background thread.
+
+    Attributes:
+        docker_manager (DockerManager): Manager of the running container
+        interval (float): Seconds between samples
+        on_sample (Optional[Callable[[Dict[str, float]], None]]): Called with the usage
+            after every sample
+        samples (List[Dict[str, float]]): Timeline of samples, each with "elapsed_seconds"
+        usage (Dict[str, float]): Usage from the last sample, with the peak memory
+            falling back to the highest sampled current memory
+        relative (bool): Whether the usage is relative to the start of sampling
+    """
+
+    def __init__(
+        self,
+        docker_manager: DockerManager,
+        interval: float,
+        on_sample: Optional[Callable[[Dict[str, float]], None]] = None,
+        relative: bool = False,
+    ):
+        """Initialize the sampler.
+
+        Args:
+            docker_manager (DockerManager): Manager of the running container
+            interval (float): Seconds between samples
+            on_sample (Optional[Callable[[Dict[str, float]], None]]): Called with the
+                usage after every sample
+            relative (bool): Measure the usage from the start of sampling, for a
+                container that already ran other jobs
+        """
+        self.docker_manager = docker_manager
+        self.interval = interval
+        self.on_sample = on_sample
+        self.samples: List[Dict[str, float]] = []
+        self.usage: Dict[str, float] = {}
+        self.relative = relative
+        self._baseline: Dict[str, float] = {}
+        self._stop = threading.Event()
+        self._thread: Optional[threading.Thread] = None
+        self._started = 0.0
+
+    def start(self) -> None:
+        """Start sampling."""
+        self._started = time.perf_counter()
+        if self.relative:
+            self._baseline = self._read() or {}
+        self._stop.clear()
+        self._thread = threading.Thread(target=self._run, name="resource-sampler", daemon=True)
+        self._thread.start()
+
+    def stop(self) -> Dict[str, float]:
+        """Stop sampling and take a final sample.
+
+        Must be called while the container is still running.
+
+        Returns:
+            Dict[str, float]: The usage of the job
+        """
+        self._stop.set()
+        if self._thread:
+            self._thread.join()
+            self._thread = None
+        self.sample()
+        return self.usage
+
+    def sample(self) -> None:
+        """Take one sample; failures are logged and skipped."""
+        stats = self._read()
+        if not stats:
+            return
+        if self.relative:
+            stats.pop("container_memory_peak_bytes", None)
+            for key, value in self._baseline.items():
+                if key.startswith(CUMULATIVE_PREFIXES) and key in stats:
+                    stats[key] = max(0, stats[key] - value)
+
+        peak = max(
+            stats.get("container_memory_peak_bytes", 0),
+            stats.get("container_memory_current_bytes", 0),
+            self.usage.get("container_memory_peak_bytes", 0),
+        )
+        if peak:
+            stats["container_memory_peak_bytes"] = peak
+        self.usage = stats
+        self.samples.append({"elapsed_seconds": time.perf_counter() - self._started, **stats})
+        if self.on_sample:
+            self.on_sample(stats)
+
+    def _read(self) -> Optional[Dict[str, float]]:
+        """Read the cgroup counters of the container."""
+        output = self.docker_manager.read_cgroup_stats(CGROUP_STATS_SCRIPT)
+        if output is None:
+            return None
+        stats = parse_cgroup_stats(output)
+        if not stats:
+            logger.debug("No cgroup counters available in the container")
+        return stats
+
+    def _run(self) -> None:
+        """Sample until stopped."""
+        while not self._stop.wait(self.interval):
+            self.sample()
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Get the sampled usage as a JSON-compatible dictionary.
+
+        Returns:
+            Dict[str, Any]: Sampling interval, usage of the job and timeline of samples
+        """
+        return {"interval_seconds": self.interval, "usage": self.usage, "samples": self.samples}
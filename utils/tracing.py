@@ -0,0 +1,333 @@
+"""Tracing Module
+
+This module records OpenTelemetry-compatible spans of analysis runs without depending
+on the OpenTelemetry SDK.
+
+Spans nest through a context variable, so a span opened in the API, the analyzer or
+the Docker manager automatically becomes the child of the span that is active in the
+calling code. The trace context is propagated in the W3C ``traceparent`` format: it is
+accepted from incoming requests and passed into the Joern container as the TRACEPARENT
+environment variable of every ``docker exec``, where analysis.sc records child spans
+that are imported back with import_spans().
+
+When a local root span ends, the spans of its trace are exported in the OTLP/JSON
+format, either appended as one line to a file or posted to an OTLP/HTTP collector.
+"""
+
+import secrets
+import threading
+import time
+from contextlib import contextmanager
+from contextvars import ContextVar
+from pathlib import Path
+from typing import Any, Dict, Iterator, List, Optional, Tuple, Union
+
+import requests
+from loguru import logger
+
+from settings import TRACING_SETTINGS
+from utils.file_handler import FileHandler
+
+# Environment variable carrying the trace context into the container
+TRACEPARENT_ENV = "TRACEPARENT"
+
+# OTLP span kinds
+SPAN_KIND_INTERNAL = 1
+SPAN_KIND_SERVER = 2
+SPAN_KIND_CLIENT = 3
+
+# OTLP status codes
+STATUS_OK = 1
+STATUS_ERROR = 2
+
+AttributeValue = Union[str, int, float, bool]
+
+
+def parse_traceparent(traceparent: Optional[str]) -> Optional[Tuple[str, str]]:
+    """Parse a W3C traceparent header.
+
+    Args:
+        traceparent (Optional[str]): Header value, e.g. ``00-<trace id>-<span id>-01``
+
+    Returns:
+        Optional[Tuple[str, str]]: Trace ID and parent span ID, or None if the value is
+            missing or malformed
+    """
+    if not traceparent:
+        return None
+    parts = traceparent.strip().split("-")
+    if len(parts) != 4 or len(parts[1]) != 32 or len(parts[2]) != 16:
+        return None
+    try:
+        int(parts[1], 16), int(parts[2], 16)
+    except ValueError:
+        return None
+    if parts[1] == "0" * 32 or parts[2] == "0" * 16:
+        return None
+    return parts[1], parts[2]
+
+
+def _otlp_value(value: AttributeValue) -> Dict[str, Any]:
+    """Encode an attribute value as an OTLP AnyValue."""
+    if isinstance(value, bool):
+        return {"boolValue": value}
+    if isinstance(value, int):
+        return {"intValue": str(value)}
+    if isinstance(value, float):
+        return {"doubleValue": value}
+    return {"stringValue": str(value)}
+
+
+def _scalar_attributes(attributes: Any) -> Dict[str, AttributeValue]:
+    """Keep only the attributes with scalar values of a decoded attribute map."""
+    if not isinstance(attributes, dict):
+        return {}
+    return {str(key): value for key, value in attributes.items() if isinstance(value, (str, int, float, bool))}
+
+
+class Span:
+    """A timed operation within a trace.
+
+    Attributes:
+        name (str): Name of the operation
+        trace_id (str): 32 hex digit trace ID
+        span_id (str): 16 hex digit span ID
+        parent_span_id (str): Span ID of the parent, empty for a root span
+        kind (int): OTLP span kind
+        attributes (Dict[str, AttributeValue]): Attributes of the operation
+        start_ns (int): Start time in nanoseconds since the epoch
+        end_ns (int): End time in nanoseconds since the epoch, 0 while running
+        status (int): OTLP status code
+        status_message (str): Error message if the operation failed
+    """
+
+    def __init__(self, name: str, trace_id: str, parent_span_id: str = "", kind: int = SPAN_KIND_INTERNAL):
+        """Start a span.
+
+        Args:
+            name (str): Name of the operation
+            trace_id (str): Trace ID the span belongs to
+            parent_span_id (str): Span ID of the parent
+            kind (int): OTLP span kind
+        """
+        self.name = name
+        self.trace_id = trace_id
+        self.span_id = secrets.token_hex(8)
+        self.parent_span_id = parent_span_id
+        self.kind = kind
+        self.attributes: Dict[str, AttributeValue] = {}
+        self.start_ns = time.time_ns()
+        self.end_ns = 0
+        self.status = STATUS_OK
+        self.status_message = ""
+        # Finished spans of the local trace, shared by all spans below the same local root
+        self.trace_spans: List[Dict[str, Any]] = []
+
+    def set_attribute(self, key: str, value: AttributeValue) -> None:
+        """Set an attribute of the span.
+
+        Args:
+            key (str): Attribute name, e.g. ``code.id``
+            value (AttributeValue): Attribute value
+        """
+        self.attributes[key] = value
+
+    def set_error(self, message: str) -> None:
+        """Mark the span as failed.
+
+        Args:
+            message (str): Error message
+        """
+        self.status = STATUS_ERROR
+        self.status_message = message
+
+    def traceparent(self) -> str:
+        """Get the W3C traceparent of the span, for propagation to child processes.
+
+        Returns:
+            str: The traceparent header value
+        """
+        return f"00-{self.trace_id}-{self.span_id}-01"
+
+    def to_otlp(self) -> Dict[str, Any]:
+        """Encode the span in the OTLP/JSON format.
+
+        Returns:
+            Dict[str, Any]: The OTLP span
+        """
+        span: Dict[str, Any] = {
+            "traceId": self.trace_id,
+            "spanId": self.span_id,
+            "name": self.name,
+            "kind": self.kind,
+            "startTimeUnixNano": str(self.start_ns),
+            "endTimeUnixNano": str(self.end_ns),
+            "attributes": [{"key": key, "value": _otlp_value(value)} for key, value in self.attributes.items()],
+            "status": {"code": self.status, "message": self.status_message},
+        }
+        if self.parent_span_id:
+            span["parentSpanId"] = self.parent_span_id
+        return span
+
+
+_current_span: ContextVar[Optional[Span]] = ContextVar("current_span", default=None)
+
+
+class Tracer:
+    """Creates spans and exports finished traces.
+
+    Attributes:
+        service_name (str): Service name reported in the OTLP resource
+        exporter (str): "file", "otlp_http" or "none"
+        file (Path): File the traces are appended to by the file exporter
+        endpoint (str): OTLP/HTTP traces endpoint of the otlp_http exporter
+    """
+
+    # Serializes appends to the trace file across request threads
+    _lock = threading.Lock()
+
+    def __init__(self, service_name: str, exporter: str, file: Path, endpoint: str):
+        """Initialize the tracer.
+
+        Args:
+            service_name (str): Service name reported in the OTLP resource
+            exporter (str): "file", "otlp_http" or "none"
+            file (Path): File the traces are appended to by the file exporter
+            endpoint (str): OTLP/HTTP traces endpoint of the otlp_http exporter
+        """
+        self.service_name = service_name
+        self.exporter = exporter
+        self.file = file
+        self.endpoint = endpoint
+
+    @staticmethod
+    def current_span() -> Optional[Span]:
+        """Get the active span of the calling context.
+
+        Returns:
+            Optional[Span]: The active span, or None outside of any span
+        """
+        return _current_span.get()
+
+    @contextmanager
+    def span(
+        self,
+        name: str,
+        kind: int = SPAN_KIND_INTERNAL,
+        traceparent: Optional[str] = None,
+        attributes: Optional[Dict[str, AttributeValue]] = None,
+    ) -> Iterator[Span]:
+        """Record a span around a block of code.
+
+        The span is a child of the active span. Without an active span it starts a new
+        local trace, continuing the remote trace given by traceparent if any, and the
+        trace is exported when the span ends. Exceptions mark the span as failed and are
+        re-raised.
+
+        Args:
+            name (str): Name of the operation
+            kind (int): OTLP span kind
+            traceparent (Optional[str]): Remote parent, only used without an active span
+            attributes (Optional[Dict[str, AttributeValue]]): Initial attributes of the span
+
+        Yields:
+            Span: The span
+        """
+        parent = _current_span.get()
+        if parent is not None:
+            span = Span(name, parent.trace_id, parent.span_id, kind)
+            span.trace_spans = parent.trace_spans
+        else:
+            remote = parse_traceparent(traceparent)
+            trace_id, parent_span_id = remote if remote else (secrets.token_hex(16), "")
+            span = Span(name, trace_id, parent_span_id, kind)
+        span.attributes.update(attributes or {})
+
+        token = _current_span.set(span)
+        try:
+            yield span
+        except BaseException as e:
+            span.set_error(str(e))
+            raise
+        finally:
+            _current_span.reset(token)
+            span.end_ns = time.time_ns()
+            span.trace_spans.append(span.to_otlp())
+            if parent is None:
+                self._export(span.trace_spans)
+
+    def import_spans(self, spans_file: Path) -> int:
+        """Add spans recorded by another process to the active trace and remove the file.
+
+        The file holds a JSON list of spans with traceId, spanId, parentSpanId, name,
+        startTimeUnixNano, endTimeUnixNano and optional attributes (a string map), as
+        written by analysis.sc. Spans of other traces are ignored.
+
+        Args:
+            spans_file (Path): The spans file
+
+        Returns:
+            int: Number of imported spans
+        """
+        span = _current_span.get()
+        if span is None or not spans_file.exists():
+            return 0
+
+        imported = 0
+        for recorded in FileHandler.read_json(spans_file):
+            if not isinstance(recorded, dict) or recorded.get("traceId") != span.trace_id:
+                continue
+            attributes = _scalar_attributes(recorded.get("attributes", {}))
+            span.trace_spans.append(
+                {
+                    "traceId": recorded["traceId"],
+                    "spanId": recorded["spanId"],
+                    "parentSpanId": recorded["parentSpanId"],
+                    "name": recorded["name"],
+                    "kind": SPAN_KIND_INTERNAL,
+                    "startTimeUnixNano": str(recorded["startTimeUnixNano"]),
+                    "endTimeUnixNano": str(recorded["endTimeUnixNano"]),
+                    "attributes": [{"key": key, "value": _otlp_value(value)} for key, value in attributes.items()],
+                    "status": {"code": STATUS_ERROR if recorded.get("error") else STATUS_OK},
+                }
+            )
+            imported += 1
+        spans_file.unlink()
+        return imported
+
+    def _export(self, spans: List[Dict[str, Any]]) -> None:
+        """Export the spans of a finished local trace.
+
+        Export failures are logged and never fail the traced operation.
+
+        Args:
+            spans (List[Dict[str, Any]]): OTLP spans of the trace
+        """
+        if self.exporter == "none" or not spans:
+            return
+
+        request: Dict[str, Any] = {
+            "resourceSpans": [
+                {
+                    "resource": {"attributes": [{"key": "service.name", "value": _otlp_value(self.service_name)}]},
+                    "scopeSpans": [{"scope": {"name": "joern_analyzer"}, "spans": spans}],
+                }
+            ]
+        }
+        try:
+            if self.exporter == "otlp_http":
+                response = requests.post(self.endpoint, json=request, timeout=5)
+                response.raise_for_status()
+            else:
+                with self._lock:
+                    FileHandler.append_json_line(request, self.file)
+        except Exception as e:
+            logger.warning(f"Failed to export trace: {str(e)}")
+
+
+TRACER = Tracer(
+    service_name=TRACING_SETTINGS["service_name"],
+    exporter=TRACING_SETTINGS["exporter"],
+    file=Path(TRACING_SETTINGS["file"]),
+    endpoint=TRACING_SETTINGS["endpoint"],
+)
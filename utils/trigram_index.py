@@ -0,0 +1,263 @@
+"""Trigram Index Module
+
+This module provides a trigram index over function signatures and bodies for fast
+substring and regular expression search.
+
+Every function is indexed by the set of case-folded three character substrings of its
+signature and code. A query is first narrowed to the functions that contain all
+trigrams the query requires, and only those candidates are verified against the
+actual text. Regular expressions contribute the trigrams of their mandatory literal
+runs; expressions without any (e.g. top-level alternations) fall back to verifying
+every function.
+"""
+
+import re
+from typing import Any, Dict, Iterable, List, Optional, Set
+
+# Characters that have a special meaning in a regular expression outside of a character class
+_REGEX_METACHARACTERS = set(".^$*+?{}[]()|\\")
+
+# Number of argument characters following escapes like \x41 or \u00e9
+_ESCAPE_ARGUMENT_LENGTHS = {"x": 2, "u": 4, "U": 8}
+
+
+def trigrams(text: str) -> Set[str]:
+    """Get the case-folded trigrams of a text.
+
+    Args:
+        text (str): Text to split into trigrams
+
+    Returns:
+        Set[str]: The trigrams
+    """
+    folded = text.lower()
+    return {folded[i : i + 3] for i in range(len(folded) - 2)}
+
+
+def required_literals(pattern: str) -> List[str]:
+    """Extract literal runs that every match of a regular expression must contain.
+
+    The extraction is conservative: groups, character classes, escapes of word
+    characters and anything following a quantifier break a run, and a top-level
+    alternation means that no literal is required at all.
+
+    Args:
+        pattern (str): Regular expression
+
+    Returns:
+        List[str]: The required literal runs
+    """
+    runs: List[str] = []
+    current: List[str] = []
+    depth = 0
+    i = 0
+
+    def flush() -> None:
+        if current:
+            runs.append("".join(current))
+            current.clear()
+
+    while i < len(pattern):
+        char = pattern[i]
+        if char == "\\" and i + 1 < len(pattern):
+            escaped = pattern[i + 1]
+            i += 2
+            if depth == 0 and not escaped.isalnum():
+                current.append(escaped)
+                continue
+            flush()
+            # Skip the arguments of the escape so they are not mistaken for literals
+            if escaped in _ESCAPE_ARGUMENT_LENGTHS:
+                i += _ESCAPE_ARGUMENT_LENGTHS[escaped]
+            elif escaped == "N" and i < len(pattern) and pattern[i] == "{":
+                i = pattern.find("}", i) + 1 or len(pattern)
+            elif escaped.isdigit():
+                while i < len(pattern) and pattern[i].isdigit():
+                    i += 1
+            continue
+        if char == "[":
+            # Skip the character class, including a leading "]" or "^]"
+            flush()
+            i += 1
+            if i < len(pattern) and pattern[i] == "^":
+                i += 1
+            if i < len(pattern) and pattern[i] == "]":
+                i += 1
+            while i < len(pattern) and pattern[i] != "]":
+                i += 2 if pattern[i] == "\\" else 1
+            i += 1
+            continue
+        if char == "(":
+            flush()
+            depth += 1
+        elif char == ")":
+            flush()
+            depth = max(depth - 1, 0)
+        elif char == "|":
+            if depth == 0:
+                return []
+            flush()
+        elif char in "*?{":
+            # The quantified character is optional or repeated, drop it from the run
+            if current:
+                current.pop()
+            flush()
+            if char == "{":
+                i = pattern.find("}", i) + 1 or len(pattern)
+                continue
+        elif char in _REGEX_METACHARACTERS:
+            flush()
+        elif depth == 0:
+            current.append(char)
+        i += 1
+
+    flush()
+    return runs
+
+
+class TrigramIndex:
+    """A trigram index over the signatures and code of functions.
+
+    Attributes:
+        documents (List[Dict[str, Any]]): Indexed function entries (name, file,
+            lineNumber, signature); document ``i`` is function ``i`` of the indexed list
+        postings (Dict[str, List[int]]): Sorted document ids containing each trigram
+    """
+
+    def __init__(self, documents: List[Dict[str, Any]], postings: Dict[str, List[int]]):
+        """Initialize the index from its precomputed parts.
+
+        Use build() or from_dict() instead of calling this directly.
+        """
+        self.documents = documents
+        self.postings = postings
+
+    @staticmethod
+    def document_text(function: Dict[str, Any]) -> str:
+        """Get the searchable text of a function.
+
+        Args:
+            function (Dict[str, Any]): Function entry
+
+        Returns:
+            str: The signature and code of the function
+        """
+        return f"{function.get('signature', '')}\n{function.get('code', '')}"
+
+    @classmethod
+    def build(cls, functions: Iterable[Dict[str, Any]]) -> "TrigramIndex":
+        """Build the index for a list of functions.
+
+        Args:
+            functions (Iterable[Dict[str, Any]]): Function entries with signature and code
+
+        Returns:
+            TrigramIndex: The index
+        """
+        documents: List[Dict[str, Any]] = []
+        postings: Dict[str, List[int]] = {}
+        for doc_id, function in enumerate(functions):
+            documents.append(
+                {
+                    "name": function.get("name"),
+                    "file": function.get("file"),
+                    "lineNumber": function.get("lineNumber"),
+                    "signature": function.get("signature"),
+                }
+            )
+            for trigram in trigrams(cls.document_text(function)):
+                postings.setdefault(trigram, []).append(doc_id)
+
+        return cls(documents, postings)
+
+    def candidates(self, query: str, regex: bool = False) -> List[int]:
+        """Narrow a query down to the documents that may match.
+
+        Args:
+            query (str): Substring or regular expression
+            regex (bool): Whether the query is a regular expression
+
+        Returns:
+            List[int]: Sorted candidate document ids
+
+        Raises:
+            re.error: If the regular expression is invalid
+        """
+        if regex and re.compile(query).flags & re.VERBOSE:
+            # Whitespace and comments are not literal in verbose expressions
+            literals = []
+        else:
+            literals = required_literals(query) if regex else [query]
+        required: Set[str] = set()
+        for literal in literals:
+            required |= trigrams(literal)
+
+        if not required:
+            return list(range(len(self.documents)))
+
+        lists = sorted((self.postings.get(trigram, []) for trigram in required), key=len)
+        result = set(lists[0])
+        for posting in lists[1:]:
+            if not result:
+                break
+            result.intersection_update(posting)
+        return sorted(result)
+
+    def search(
+        self,
+        functions: List[Dict[str, Any]],
+        query: str,
+        regex: bool = False,
+        limit: Optional[int] = None,
+        candidates: Optional[List[int]] = None,
+    ) -> List[Dict[str, Any]]:
+        """Search the functions for a substring or regular expression.
+
+        Args:
+            functions (List[Dict[str, Any]]): The indexed function entries, used to
+                verify the candidates against their full text
+            query (str): Substring or regular expression
+            regex (bool): Whether the query is a regular expression
+            limit (Optional[int]): Maximum number of matches to return
+            candidates (Optional[List[int]]): Candidate document ids as returned by
+                candidates(); computed if not given
+
+        Returns:
+            List[Dict[str, Any]]: Matching documents in index order
+
+        Raises:
+            re.error: If the regular expression is invalid
+        """
+        compiled = re.compile(query) if regex else None
+        matches: List[Dict[str, Any]] = []
+        if candidates is None:
+            candidates = self.candidates(query, regex)
+        for doc_id in candidates:
+            text = self.document_text(functions[doc_id])
+            matched = compiled.search(text) is not None if compiled else query in text
+            if not matched:
+                continue
+            matches.append(self.documents[doc_id])
+            if limit is not None and len(matches) >= limit:
+                break
+        return matches
+
+    def to_dict(self) -> Dict[str, Any]:
+        """Serialize the index into a JSON-compatible dictionary.
+
+        Returns:
+            Dict[str, Any]: The serialized index
+        """
+        return {"documents": self.documents, "postings": self.postings}
+
+    @classmethod
+    def from_dict(cls, data: Dict[str, Any]) -> "TrigramIndex":
+        """Deserialize an index written by to_dict().
+
+        Args:
+            data (Dict[str, Any]): The serialized index
+
+        Returns:
+            TrigramIndex: The index
+        """
+        return cls(data["documents"], data["postings"])
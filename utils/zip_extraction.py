@@ -0,0 +1,103 @@
+"""Zip Extraction Module
+
+This module extracts uploaded code archives in a background thread, so that an
+analysis can wait for resources and start its container while the code is still
+being extracted (see JoernAnalyzer.analyze()).
+
+The size of the C/C++ sources is read from the central directory of the archive
+before the extraction starts, so that the resources of the job can be estimated
+without the extracted files.
+
+The archive is extracted into a hidden sibling directory of the target directory,
+and the target directory is only created when the extraction is complete, as a
+symbolic link to that directory replacing any existing one atomically. So other
+requests never take a partially extracted tree for the code, and neither does a
+restarted server after a crash during the extraction. The extracted directory
+itself is not renamed, since the container of the analysis already mounts it
+while the extraction is running.
+"""
+
+import os
+import shutil
+import threading
+import uuid
+import zipfile
+from pathlib import Path
+from typing import Callable, Optional
+
+from loguru import logger
+
+from settings import C_CPP_EXTENSIONS
+
+
+class ZipExtraction:
+    """Extraction of a zip archive into a directory in a background thread.
+
+    Attributes:
+        zip_path (Path): The archive, removed after the extraction
+        target_dir (Path): Link to the extracted directory, created once the
+            extraction is complete
+        directory (Path): Directory the archive is extracted into, removed if the
+            extraction fails
+        source_bytes (int): Uncompressed size of the C/C++ sources in the archive
+    """
+
+    def __init__(self, zip_path: Path, target_dir: Path, on_finished: Optional[Callable[[], None]] = None):
+        """Read the index of the archive.
+
+        Args:
+            zip_path (Path): The archive
+            target_dir (Path): Path of the extracted code
+            on_finished (Optional[Callable[[], None]]): Called in the extraction thread
+                when the extraction is complete or failed
+
+        Raises:
+            zipfile.BadZipFile: If the file is not a zip archive
+        """
+        self.zip_path = zip_path
+        self.target_dir = target_dir
+        self.directory = target_dir.with_name(f".{target_dir.name}.{uuid.uuid4().hex[:12]}")
+        self._on_finished = on_finished
+        with zipfile.ZipFile(zip_path, "r") as archive:
+            self.source_bytes = sum(
+                info.file_size for info in archive.infolist() if Path(info.filename).suffix in C_CPP_EXTENSIONS
+            )
+        self._error: Optional[Exception] = None
+        self._thread = threading.Thread(target=self._extract, name="zip-extraction", daemon=True)
+
+    def start(self) -> "ZipExtraction":
+        """Start extracting the archive.
+
+        Returns:
+            ZipExtraction: This extraction
+        """
+        self.directory.mkdir(parents=True)
+        self._thread.start()
+        return self
+
+    def _extract(self) -> None:
+        link = self.directory.with_name(f"{self.directory.name}.link")
+        try:
+            with zipfile.ZipFile(self.zip_path, "r") as archive:
+                archive.extractall(self.directory)
+            link.symlink_to(self.directory.name, target_is_directory=True)
+            os.replace(link, self.target_dir)
+        except Exception as e:
+            logger.error(f"Error extracting {self.zip_path}: {str(e)}")
+            self._error = e
+            link.unlink(missing_ok=True)
+            shutil.rmtree(self.directory, ignore_errors=True)
+        finally:
+            self.zip_path.unlink(missing_ok=True)
+            if self._on_finished:
+                self._on_finished()
+
+    def wait(self) -> None:
+        """Wait until the archive is extracted.
+
+        Raises:
+            RuntimeError: If the extraction failed
+        """
+        self._thread.join()
+        if self._error is not None:
+            raise RuntimeError(f"Failed to extract the code: {self._error}") from self._error